@@ -10,6 +10,7 @@
 
 #include <SFML/Window/VideoMode.hpp>
 
+#include <algorithm>
 #include <cstdlib>
 #include <filesystem>
 #include <iostream>
@@ -38,6 +39,28 @@ namespace word_stacker
     const std::string ArgsParser::M_ARG_FLAGGED_WORDS_FILE_SHORT{ "-l" };
     const std::string ArgsParser::M_ARG_PARSE_HTML{ "--parse-html=" };
     const std::string ArgsParser::M_ARG_PARSE_HTML_SHORT{ "-m" };
+    const std::string ArgsParser::M_ARG_CONCURRENT_COUNTS{ "--concurrent-counts=" };
+    const std::string ArgsParser::M_ARG_CONCURRENT_COUNTS_SHORT{ "-k" };
+    const std::string ArgsParser::M_ARG_BENCHMARK_KERNELS{ "--benchmark-kernels=" };
+    const std::string ArgsParser::M_ARG_BENCHMARK_KERNELS_SHORT{ "-b" };
+    const std::string ArgsParser::M_ARG_ALL_FILES{ "--all-files=" };
+    const std::string ArgsParser::M_ARG_ALL_FILES_SHORT{ "-a" };
+    const std::string ArgsParser::M_ARG_SKIP_DUPLICATES{ "--skip-duplicates=" };
+    const std::string ArgsParser::M_ARG_SKIP_DUPLICATES_SHORT{ "-d" };
+    const std::string ArgsParser::M_ARG_REUSE_DUPLICATES{ "--reuse-duplicates=" };
+    const std::string ArgsParser::M_ARG_REUSE_DUPLICATES_SHORT{ "-r" };
+    const std::string ArgsParser::M_ARG_EXCLUDE_BOILERPLATE{ "--exclude-boilerplate=" };
+    const std::string ArgsParser::M_ARG_EXCLUDE_BOILERPLATE_SHORT{ "-e" };
+    const std::string ArgsParser::M_ARG_BOILERPLATE_ONCE{ "--boilerplate-once=" };
+    const std::string ArgsParser::M_ARG_BOILERPLATE_ONCE_SHORT{ "-o" };
+    const std::string ArgsParser::M_ARG_SPLIT_IDENTIFIERS{ "--split-identifiers=" };
+    const std::string ArgsParser::M_ARG_SPLIT_IDENTIFIERS_SHORT{ "-p" };
+    const std::string ArgsParser::M_ARG_KEEP_IDENTIFIERS{ "--keep-identifiers=" };
+    const std::string ArgsParser::M_ARG_KEEP_IDENTIFIERS_SHORT{ "-j" };
+    const std::string ArgsParser::M_ARG_SPLIT_VOCABULARIES{ "--split-vocabularies=" };
+    const std::string ArgsParser::M_ARG_SPLIT_VOCABULARIES_SHORT{ "-u" };
+    const std::string ArgsParser::M_ARG_LAYOUT_CHURN_MAX{ "--layout-churn-max=" };
+    const std::string ArgsParser::M_ARG_LAYOUT_CHURN_MAX_SHORT{ "-g" };
     const int ArgsParser::M_FONT_SIZE_MAX{ 999 };
 
     ArgsParser::ArgsParser(
@@ -57,10 +80,21 @@ namespace word_stacker
         , m_isPathADireectory(false)
         , m_fontSizeMin(30)
         , m_fontSizeMax(400)
+        , m_layoutChurnMax(25)
         , m_willSkipDisplay(false)
         , m_willVerbose(false)
         , m_flaggedWordsPaths()
         , m_willParseHTML(false)
+        , m_willUseConcurrentCounts(false)
+        , m_willBenchmarkKernels(false)
+        , m_willParseAllFiles(false)
+        , m_willSkipDuplicates(false)
+        , m_willReuseDuplicates(false)
+        , m_willExcludeBoilerplate(false)
+        , m_willCountBoilerplateOnce(false)
+        , m_willSplitIdentifiers(false)
+        , m_willKeepIdentifiers(false)
+        , m_willSplitVocabularies(false)
     {
         ParseCommandLineArguments(reportMaker, ARGC, ARGV);
         EnsureValidStartingValues(reportMaker);
@@ -81,7 +115,7 @@ namespace word_stacker
             if (ARG == M_ARG_HELP_SHORT)
             {
                 std::cout
-                    << "  Usage:  word_stacker [-wsvhm] "
+                    << "  Usage:  word_stacker [-wsvhmkbadreopju] "
                     << "[-t Text/Code] <-f font> [-c common words file] [-i ignored words file] "
                     << "[-n font size min] [-x font size max] <FILE or DIR to parse>\n"
                     << "Try 'word_stacker --help' for more information." << std::endl;
@@ -95,7 +129,7 @@ namespace word_stacker
                 std::cout
                     << "  Parses all .txt or all .hpp/.cpp files and then displays word frequency information in columns or in a jumble.\n"
                     << '\n'
-                    << "  Usage:  word_stacker [-wsvhm] [-t Text/Code] <-f font> [-c common words file] [-i ignored words file] [-n font size min] [-x font size max] <FILE or DIR to parse ...>\n"
+                    << "  Usage:  word_stacker [-wsvhmkbadreopju] [-t Text/Code] <-f font> [-c common words file] [-i ignored words file] [-n font size min] [-x font size max] <FILE or DIR to parse ...>\n"
                     << '\n'
                     << "Options:\n"
                     << "  -w, --will-ignore-common=yes/no      prevents the display of words in the common words file\n"
@@ -105,9 +139,20 @@ namespace word_stacker
                     << "  -f, --font=FILE                      font to use\n"
                     << "  -n, --font-size-min=[1,999]          REQUIRED, smallest font size, must be <= max, defaults to 30\n"
                     << "  -x, --font-size-max=[1,999]          largest font size, must be >= min, defaults to 400\n"
+                    << "  -g, --layout-churn-max=[0,100]       percent of the words shown that may change before a jumble or spiral is laid out from scratch, defaults to 25\n"
                     << "  -c, --common=FILE                    file containing common words in order\n"
                     << "  -i, --ignore=FILE                    file containing words to be ignored\n"
                     << "  -m, --parse-html=yes/no              when parsing code also parse html, defaults to no\n"
+                    << "  -k, --concurrent-counts=yes/no       count into one shared lock-striped table instead of merging per-thread tables, defaults to no\n"
+                    << "  -b, --benchmark-kernels=yes/no       time every tokenizing kernel on a sample of the files, defaults to no\n"
+                    << "  -a, --all-files=yes/no               parse files even if a .gitignore/.ignore lists them or they look binary, defaults to no\n"
+                    << "  -d, --skip-duplicates=yes/no         parse files with the same contents only once and ignore the copies, defaults to no\n"
+                    << "  -r, --reuse-duplicates=yes/no        parse files with the same contents only once but count every copy, defaults to no\n"
+                    << "  -e, --exclude-boilerplate=yes/no     leave out blocks of lines that start many files, like license headers, defaults to no\n"
+                    << "  -o, --boilerplate-once=yes/no        count blocks of lines that start many files only once, defaults to no\n"
+                    << "  -p, --split-identifiers=yes/no       Code only, count the parts of identifiers split on case, _, and digits.\n"
+                    << "  -j, --keep-identifiers=yes/no        Code only, like -p but also count each identifier that was split.\n"
+                    << "  -u, --split-vocabularies=yes/no      Code only, also count words in comments and strings, press V to show them.\n"
                     << "  -h, --help                           echos this help message\n"
                     << '\n'
                     << "    Similar to a word cloud, the size and color of each word is proportional\n"
@@ -133,6 +178,7 @@ namespace word_stacker
                     << "    A font must be specified on the command line with '-f FILE' or '--font=FILE'." << '\n'
                     << "    Press 'escape', 'q', 'e', or 'c' to exit.\n"
                     << "    Press 'return' to toggle between column and jumble view.\n"
+                    << "    In canvas view, scroll to zoom, and drag or press the arrow keys to pan.\n"
                     << "    Press 'spacebar' to toggle between showing and not showing the frequency, or count, next to each word.\n"
                     << "    Press 's' to save screenshots in PNG format.\n"
                     << "    Press 'r' to save a text report file.\n"
@@ -172,6 +218,38 @@ namespace word_stacker
                 continue;
             }
 
+            auto const IS_ARG_LAYOUT_CHURN_MAX_SHORT{ ARG == M_ARG_LAYOUT_CHURN_MAX_SHORT };
+            if (IS_ARG_LAYOUT_CHURN_MAX_SHORT || utilz::startsWith(ARG, M_ARG_LAYOUT_CHURN_MAX))
+            {
+                // only the short version takes its value from the next arg
+                auto const VALUE{ (
+                    (IS_ARG_LAYOUT_CHURN_MAX_SHORT)
+                        ? (((i + 1) < ARGC) ? std::string(ARGV[++i]) : std::string(""))
+                        : utilz::replaceAllCopy(ARG, M_ARG_LAYOUT_CHURN_MAX, "")) };
+
+                auto const IS_PERCENT{ (VALUE.empty() == false) && (VALUE.size() <= 3) &&
+                                       std::all_of(
+                                           std::begin(VALUE),
+                                           std::end(VALUE),
+                                           [](const char CH) { return utilz::isDigit(CH); }) &&
+                                       (std::atoi(VALUE.c_str()) <= 100) };
+
+                M_LOG_AND_ASSERT_OR_THROW(
+                    IS_PERCENT,
+                    "Invalid argument: " << ARG << " of \"" << VALUE << "\""
+                                         << " (should be a percent from 0 to 100)");
+
+                m_layoutChurnMax = static_cast<unsigned>(std::atoi(VALUE.c_str()));
+
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream()
+                        << "Setting layout churn max to " << m_layoutChurnMax << "%";
+                }
+
+                continue;
+            }
+
             auto const FONT_PATH{ parseCommandLineArgFile(
                 ARGC, ARGV, i, M_ARG_FONT_FILE, M_ARG_FONT_FILE_SHORT) };
 
@@ -271,6 +349,150 @@ namespace word_stacker
                 continue;
             }
 
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willUseConcurrentCounts,
+                    M_ARG_CONCURRENT_COUNTS,
+                    M_ARG_CONCURRENT_COUNTS_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will use concurrent counts to "
+                                                  << std::boolalpha << m_willUseConcurrentCounts;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willBenchmarkKernels,
+                    M_ARG_BENCHMARK_KERNELS,
+                    M_ARG_BENCHMARK_KERNELS_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will benchmark kernels to "
+                                                  << std::boolalpha << m_willBenchmarkKernels;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG, m_willParseAllFiles, M_ARG_ALL_FILES, M_ARG_ALL_FILES_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will parse all files to "
+                                                  << std::boolalpha << m_willParseAllFiles;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG, m_willSkipDuplicates, M_ARG_SKIP_DUPLICATES, M_ARG_SKIP_DUPLICATES_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will skip duplicates to "
+                                                  << std::boolalpha << m_willSkipDuplicates;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willReuseDuplicates,
+                    M_ARG_REUSE_DUPLICATES,
+                    M_ARG_REUSE_DUPLICATES_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will reuse duplicates to "
+                                                  << std::boolalpha << m_willReuseDuplicates;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willExcludeBoilerplate,
+                    M_ARG_EXCLUDE_BOILERPLATE,
+                    M_ARG_EXCLUDE_BOILERPLATE_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will exclude boilerplate to "
+                                                  << std::boolalpha << m_willExcludeBoilerplate;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willCountBoilerplateOnce,
+                    M_ARG_BOILERPLATE_ONCE,
+                    M_ARG_BOILERPLATE_ONCE_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting will count boilerplate once to "
+                                                  << std::boolalpha << m_willCountBoilerplateOnce;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willSplitIdentifiers,
+                    M_ARG_SPLIT_IDENTIFIERS,
+                    M_ARG_SPLIT_IDENTIFIERS_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting split identifiers to "
+                                                  << std::boolalpha << m_willSplitIdentifiers;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willKeepIdentifiers,
+                    M_ARG_KEEP_IDENTIFIERS,
+                    M_ARG_KEEP_IDENTIFIERS_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting keep identifiers to "
+                                                  << std::boolalpha << m_willKeepIdentifiers;
+                }
+
+                continue;
+            }
+
+            if (parseCommandLineArgFlag(
+                    ARG,
+                    m_willSplitVocabularies,
+                    M_ARG_SPLIT_VOCABULARIES,
+                    M_ARG_SPLIT_VOCABULARIES_SHORT))
+            {
+                if (m_willVerbose)
+                {
+                    reportMaker.argumentsStream() << "Setting split vocabularies to "
+                                                  << std::boolalpha << m_willSplitVocabularies;
+                }
+
+                continue;
+            }
+
             if (parseCommandLineArgFlag(ARG, m_willVerbose, M_ARG_VERBOSE, M_ARG_VERBOSE_SHORT))
             {
                 continue;
@@ -312,6 +534,56 @@ namespace word_stacker
                             m_willParseHTML = true;
                             break;
                         }
+                        case 'k':
+                        {
+                            m_willUseConcurrentCounts = true;
+                            break;
+                        }
+                        case 'b':
+                        {
+                            m_willBenchmarkKernels = true;
+                            break;
+                        }
+                        case 'a':
+                        {
+                            m_willParseAllFiles = true;
+                            break;
+                        }
+                        case 'd':
+                        {
+                            m_willSkipDuplicates = true;
+                            break;
+                        }
+                        case 'r':
+                        {
+                            m_willReuseDuplicates = true;
+                            break;
+                        }
+                        case 'e':
+                        {
+                            m_willExcludeBoilerplate = true;
+                            break;
+                        }
+                        case 'o':
+                        {
+                            m_willCountBoilerplateOnce = true;
+                            break;
+                        }
+                        case 'p':
+                        {
+                            m_willSplitIdentifiers = true;
+                            break;
+                        }
+                        case 'j':
+                        {
+                            m_willKeepIdentifiers = true;
+                            break;
+                        }
+                        case 'u':
+                        {
+                            m_willSplitVocabularies = true;
+                            break;
+                        }
                         default:
                         {
                             reportMaker.errorsStream()
@@ -48,12 +48,40 @@ namespace word_stacker
 
         inline unsigned fontSizeMax() const { return m_fontSizeMax; }
 
+        // the percent of the words shown that may change rank or size before a layout is made
+        // from scratch, instead of keeping the others where they were
+        inline unsigned layoutChurnMax() const { return m_layoutChurnMax; }
+
         inline bool willSkipDisplay() const { return m_willSkipDisplay; }
 
         inline bool willVerbose() const { return m_willVerbose; }
 
         inline bool willParseHTML() const { return m_willParseHTML; }
 
+        inline bool willUseConcurrentCounts() const { return m_willUseConcurrentCounts; }
+
+        inline bool willBenchmarkKernels() const { return m_willBenchmarkKernels; }
+
+        inline bool willParseAllFiles() const { return m_willParseAllFiles; }
+
+        inline bool willSkipDuplicates() const { return m_willSkipDuplicates; }
+
+        inline bool willReuseDuplicates() const { return m_willReuseDuplicates; }
+
+        inline bool willExcludeBoilerplate() const { return m_willExcludeBoilerplate; }
+
+        inline bool willCountBoilerplateOnce() const { return m_willCountBoilerplateOnce; }
+
+        // keeping identifiers only means something when they are split, so it implies splitting
+        inline bool willSplitIdentifiers() const
+        {
+            return (m_willSplitIdentifiers || m_willKeepIdentifiers);
+        }
+
+        inline bool willKeepIdentifiers() const { return m_willKeepIdentifiers; }
+
+        inline bool willSplitVocabularies() const { return m_willSplitVocabularies; }
+
         inline const StrVec_t & parsePaths() const { return m_paths; }
 
         inline const StrVec_t & ignoredWordsPaths() const { return m_ignoreWordsPaths; }
@@ -109,6 +137,28 @@ namespace word_stacker
         static const std::string M_ARG_FLAGGED_WORDS_FILE_SHORT;
         static const std::string M_ARG_PARSE_HTML;
         static const std::string M_ARG_PARSE_HTML_SHORT;
+        static const std::string M_ARG_CONCURRENT_COUNTS;
+        static const std::string M_ARG_CONCURRENT_COUNTS_SHORT;
+        static const std::string M_ARG_BENCHMARK_KERNELS;
+        static const std::string M_ARG_BENCHMARK_KERNELS_SHORT;
+        static const std::string M_ARG_ALL_FILES;
+        static const std::string M_ARG_ALL_FILES_SHORT;
+        static const std::string M_ARG_SKIP_DUPLICATES;
+        static const std::string M_ARG_SKIP_DUPLICATES_SHORT;
+        static const std::string M_ARG_REUSE_DUPLICATES;
+        static const std::string M_ARG_REUSE_DUPLICATES_SHORT;
+        static const std::string M_ARG_EXCLUDE_BOILERPLATE;
+        static const std::string M_ARG_EXCLUDE_BOILERPLATE_SHORT;
+        static const std::string M_ARG_BOILERPLATE_ONCE;
+        static const std::string M_ARG_BOILERPLATE_ONCE_SHORT;
+        static const std::string M_ARG_SPLIT_IDENTIFIERS;
+        static const std::string M_ARG_SPLIT_IDENTIFIERS_SHORT;
+        static const std::string M_ARG_KEEP_IDENTIFIERS;
+        static const std::string M_ARG_KEEP_IDENTIFIERS_SHORT;
+        static const std::string M_ARG_SPLIT_VOCABULARIES;
+        static const std::string M_ARG_SPLIT_VOCABULARIES_SHORT;
+        static const std::string M_ARG_LAYOUT_CHURN_MAX;
+        static const std::string M_ARG_LAYOUT_CHURN_MAX_SHORT;
         static const int M_FONT_SIZE_MAX;
 
         ParseType::Enum m_parseType;
@@ -123,10 +173,21 @@ namespace word_stacker
         bool m_isPathADireectory;
         unsigned m_fontSizeMin;
         unsigned m_fontSizeMax;
+        unsigned m_layoutChurnMax;
         bool m_willSkipDisplay;
         bool m_willVerbose;
         StrVec_t m_flaggedWordsPaths;
         bool m_willParseHTML;
+        bool m_willUseConcurrentCounts;
+        bool m_willBenchmarkKernels;
+        bool m_willParseAllFiles;
+        bool m_willSkipDuplicates;
+        bool m_willReuseDuplicates;
+        bool m_willExcludeBoilerplate;
+        bool m_willCountBoilerplateOnce;
+        bool m_willSplitIdentifiers;
+        bool m_willKeepIdentifiers;
+        bool m_willSplitVocabularies;
     };
 
 } // namespace word_stacker
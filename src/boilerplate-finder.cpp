@@ -0,0 +1,370 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// boilerplate-finder.cpp
+//
+#include "boilerplate-finder.hpp"
+
+#include <cstring>
+
+namespace word_stacker
+{
+
+    const std::size_t BoilerplateFinder::LINES_MAX{ 64 };
+    const std::size_t BoilerplateFinder::WINDOW_LINES{ 4 };
+    const std::size_t BoilerplateFinder::WINDOW_SIZE_MIN{ 120 };
+    const std::size_t BoilerplateFinder::RUN_GAP_MAX{ 2 };
+    const std::size_t BoilerplateFinder::WINDOW_COUNT_MAX{ 1 << 19 };
+
+    BoilerplateFinder::BoilerplateFinder(const std::size_t FILE_COUNT_MIN)
+        : M_FILE_COUNT_MIN(FILE_COUNT_MIN)
+        , m_windows(1 << 16)
+        , m_windowCount(0)
+        , m_fileNumber(0)
+        , m_knownWindowCount(0)
+        , m_distinctRunHashes()
+        , m_distinctText()
+        , m_distinctLineCount(0)
+        , m_strippedFileCount(0)
+        , m_strippedLineCount(0)
+        , m_lineStarts()
+        , m_lineHashes()
+        , m_scannedBeginPtr(nullptr)
+        , m_scannedSize(0)
+        , m_windowHashes()
+        , m_windowFileCounts()
+        , m_isLineCovered()
+    {}
+
+    std::size_t BoilerplateFinder::scanSize(const char * const BEGIN, const std::size_t SIZE)
+    {
+        std::size_t pos{ 0 };
+
+        for (std::size_t line(0); (line < LINES_MAX) && (pos < SIZE); ++line)
+        {
+            auto const * const NEWLINE_PTR{ static_cast<const char *>(
+                std::memchr((BEGIN + pos), '\n', (SIZE - pos))) };
+
+            if (nullptr == NEWLINE_PTR)
+            {
+                return SIZE;
+            }
+
+            pos = (static_cast<std::size_t>(NEWLINE_PTR - BEGIN) + 1);
+        }
+
+        return pos;
+    }
+
+    void BoilerplateFinder::learn(const char * const BEGIN, const std::size_t SIZE)
+    {
+        ++m_fileNumber;
+        scan(BEGIN, SIZE);
+
+        m_windowFileCounts.assign(m_windowHashes.size(), 0);
+
+        for (std::size_t i(0); i < m_windowHashes.size(); ++i)
+        {
+            auto const WINDOW_HASH{ m_windowHashes[i] };
+
+            if (0 == WINDOW_HASH)
+            {
+                continue;
+            }
+
+            auto & window{ m_windows[findSlot(WINDOW_HASH)] };
+
+            if (0 == window.hash)
+            {
+                window.hash = WINDOW_HASH;
+                ++m_windowCount;
+            }
+
+            // a window repeated inside one file still only counts once
+            if (window.lastFileNumber != m_fileNumber)
+            {
+                window.lastFileNumber = m_fileNumber;
+
+                if (++window.fileCount == M_FILE_COUNT_MIN)
+                {
+                    ++m_knownWindowCount;
+                }
+            }
+
+            m_windowFileCounts[i] = window.fileCount;
+        }
+
+        // so a strip() of this same file can skip the scan and the lookups
+        m_scannedBeginPtr = BEGIN;
+        m_scannedSize = SIZE;
+
+        if (m_windowCount > WINDOW_COUNT_MAX)
+        {
+            forgetRareWindows();
+        }
+        else if ((m_windowCount * 2) > m_windows.size())
+        {
+            rebuildWindows((m_windows.size() * 2), 0);
+        }
+    }
+
+    void BoilerplateFinder::strip(
+        const char * const BEGIN,
+        const std::size_t SIZE,
+        std::string & text,
+        std::string & strippedText)
+    {
+        text.clear();
+        strippedText.clear();
+
+        // read buffers are reused, so only the very next call can trust an address and size
+        auto const IS_LEARNED{ ((BEGIN == m_scannedBeginPtr) && (SIZE == m_scannedSize)) };
+        m_scannedBeginPtr = nullptr;
+
+        if (0 == m_knownWindowCount)
+        {
+            text.assign(BEGIN, SIZE);
+            return;
+        }
+
+        if (IS_LEARNED == false)
+        {
+            scan(BEGIN, SIZE);
+        }
+
+        auto const LINE_COUNT{ m_lineHashes.size() };
+        m_isLineCovered.assign(LINE_COUNT, 0);
+
+        auto isAnyLineCovered{ false };
+
+        for (std::size_t i(0); i < m_windowHashes.size(); ++i)
+        {
+            auto const IS_KNOWN{ (
+                (IS_LEARNED) ? (m_windowFileCounts[i] >= M_FILE_COUNT_MIN)
+                             : isKnown(m_windowHashes[i])) };
+
+            if (IS_KNOWN)
+            {
+                isAnyLineCovered = true;
+
+                for (std::size_t w(0); w < WINDOW_LINES; ++w)
+                {
+                    m_isLineCovered[i + w] = 1;
+                }
+            }
+        }
+
+        if (isAnyLineCovered == false)
+        {
+            text.assign(BEGIN, SIZE);
+            return;
+        }
+
+        text.reserve(SIZE);
+
+        // where the last run cut ended, or the start of the file
+        std::size_t cutEnd{ 0 };
+
+        std::size_t line{ 0 };
+        while (line < LINE_COUNT)
+        {
+            if (0 == m_isLineCovered[line])
+            {
+                text.append(
+                    (BEGIN + m_lineStarts[line]), (m_lineStarts[line + 1] - m_lineStarts[line]));
+                ++line;
+                continue;
+            }
+
+            auto const RUN_START{ line };
+            std::uint64_t runHash{ 0 };
+
+            while ((line < LINE_COUNT) && (m_isLineCovered[line] != 0))
+            {
+                runHash = ((runHash * 0x9e3779b97f4a7c15ULL) + m_lineHashes[line]);
+                ++line;
+            }
+
+            auto const RUN_BEGIN_PTR{ BEGIN + m_lineStarts[RUN_START] };
+            auto const RUN_SIZE{ m_lineStarts[line] - m_lineStarts[RUN_START] };
+
+            // too far from the start to be a header, so more likely code shared between files
+            if ((RUN_START - cutEnd) > RUN_GAP_MAX)
+            {
+                text.append(RUN_BEGIN_PTR, RUN_SIZE);
+                continue;
+            }
+
+            cutEnd = line;
+
+            if (strippedText.empty())
+            {
+                ++m_strippedFileCount;
+            }
+
+            strippedText.append(RUN_BEGIN_PTR, RUN_SIZE);
+            m_strippedLineCount += (line - RUN_START);
+
+            if (m_distinctRunHashes.insert(runHash).second)
+            {
+                m_distinctText.append(RUN_BEGIN_PTR, RUN_SIZE);
+
+                if (m_distinctText.back() != '\n')
+                {
+                    m_distinctText.push_back('\n');
+                }
+
+                m_distinctLineCount += (line - RUN_START);
+            }
+        }
+
+        text.append((BEGIN + m_lineStarts[LINE_COUNT]), (SIZE - m_lineStarts[LINE_COUNT]));
+    }
+
+    void BoilerplateFinder::scan(const char * const BEGIN, const std::size_t SIZE)
+    {
+        m_lineStarts.clear();
+        m_lineHashes.clear();
+        m_windowHashes.clear();
+
+        std::size_t pos{ 0 };
+        while ((pos < SIZE) && (m_lineHashes.size() < LINES_MAX))
+        {
+            m_lineStarts.push_back(pos);
+
+            auto const * const NEWLINE_PTR{ static_cast<const char *>(
+                std::memchr((BEGIN + pos), '\n', (SIZE - pos))) };
+
+            auto const END{ (
+                (nullptr == NEWLINE_PTR) ? SIZE : static_cast<std::size_t>(NEWLINE_PTR - BEGIN)) };
+
+            // carriage returns are ignored so that the same block matches with either line ending
+            auto hashEnd{ END };
+            if ((hashEnd > pos) && (BEGIN[hashEnd - 1] == '\r'))
+            {
+                --hashEnd;
+            }
+
+            m_lineHashes.push_back(hashLine((BEGIN + pos), (hashEnd - pos)));
+            pos = ((END < SIZE) ? (END + 1) : SIZE);
+        }
+
+        m_lineStarts.push_back(pos);
+
+        auto const LINE_COUNT{ m_lineHashes.size() };
+
+        if (LINE_COUNT < WINDOW_LINES)
+        {
+            return;
+        }
+
+        // a polynomial rolling hash, the line leaving the window is taken back out
+        const std::uint64_t BASE{ 0x9e3779b97f4a7c15ULL };
+
+        std::uint64_t basePower{ 1 };
+        for (std::size_t w(0); w < WINDOW_LINES; ++w)
+        {
+            basePower *= BASE;
+        }
+
+        m_windowHashes.resize((LINE_COUNT - WINDOW_LINES) + 1, 0);
+
+        std::uint64_t windowHash{ 0 };
+        for (std::size_t i(0); i < LINE_COUNT; ++i)
+        {
+            windowHash = ((windowHash * BASE) + m_lineHashes[i]);
+
+            if (i >= WINDOW_LINES)
+            {
+                windowHash -= (m_lineHashes[i - WINDOW_LINES] * basePower);
+            }
+
+            if ((i + 1) < WINDOW_LINES)
+            {
+                continue;
+            }
+
+            auto const WINDOW_START{ (i + 1) - WINDOW_LINES };
+
+            auto const WINDOW_SIZE{ m_lineStarts[i + 1] - m_lineStarts[WINDOW_START] };
+
+            // the low bit is always set so that zero can mean too short
+            if (WINDOW_SIZE >= WINDOW_SIZE_MIN)
+            {
+                m_windowHashes[WINDOW_START] = (windowHash | 1);
+            }
+        }
+    }
+
+    std::uint64_t BoilerplateFinder::hashLine(const char * const BEGIN, const std::size_t SIZE)
+    {
+        const std::uint64_t MULTIPLIER{ 0x9fb21c651e98df25ULL };
+
+        // eight bytes at a time, the size is mixed in so the zero padding of the tail is safe
+        std::uint64_t hash{ SIZE * MULTIPLIER };
+
+        for (std::size_t i(0); i < SIZE; i += 8)
+        {
+            std::uint64_t word{ 0 };
+            std::memcpy(&word, (BEGIN + i), (((SIZE - i) < 8) ? (SIZE - i) : 8));
+
+            hash = ((hash ^ word) * MULTIPLIER);
+            hash ^= (hash >> 29);
+        }
+
+        return hash;
+    }
+
+    bool BoilerplateFinder::isKnown(const std::uint64_t WINDOW_HASH) const
+    {
+        if (0 == WINDOW_HASH)
+        {
+            return false;
+        }
+
+        return (m_windows[findSlot(WINDOW_HASH)].fileCount >= M_FILE_COUNT_MIN);
+    }
+
+    std::size_t BoilerplateFinder::findSlot(const std::uint64_t WINDOW_HASH) const
+    {
+        // the low bit is always set, and the size is always a power of two
+        auto const MASK{ m_windows.size() - 1 };
+        auto slot{ (WINDOW_HASH >> 1) & MASK };
+
+        while ((m_windows[slot].hash != 0) && (m_windows[slot].hash != WINDOW_HASH))
+        {
+            slot = ((slot + 1) & MASK);
+        }
+
+        return slot;
+    }
+
+    void BoilerplateFinder::rebuildWindows(
+        const std::size_t SLOT_COUNT, const std::size_t FILE_COUNT_MIN)
+    {
+        std::vector<Window> oldWindows(SLOT_COUNT);
+        oldWindows.swap(m_windows);
+        m_windowCount = 0;
+
+        for (auto const & WINDOW : oldWindows)
+        {
+            if ((WINDOW.hash != 0) && (WINDOW.fileCount >= FILE_COUNT_MIN))
+            {
+                m_windows[findSlot(WINDOW.hash)] = WINDOW;
+                ++m_windowCount;
+            }
+        }
+    }
+
+    void BoilerplateFinder::forgetRareWindows()
+    {
+        // windows only seen once are almost all of them, so those go first
+        rebuildWindows(m_windows.size(), 2);
+
+        if (m_windowCount > (WINDOW_COUNT_MAX / 2))
+        {
+            rebuildWindows(m_windows.size(), M_FILE_COUNT_MIN);
+        }
+    }
+
+} // namespace word_stacker
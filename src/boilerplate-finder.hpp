@@ -0,0 +1,122 @@
+#ifndef WORDSTACKER_BOILERPLATEFINDER_HPP_INCLUDED
+#define WORDSTACKER_BOILERPLATEFINDER_HPP_INCLUDED
+//
+// boilerplate-finder.hpp
+//
+#include <cstddef> //for std::size_t
+#include <cstdint>
+#include <set>
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for finding blocks of lines that start many files, like license headers and
+    // generated banners, and for cutting them out of each file before it is tokenized.  Every
+    // WINDOW_LINES lines in a row get a rolling hash, and a window seen in FILE_COUNT_MIN
+    // different files is boilerplate from then on.  Only the first LINES_MAX lines of each file
+    // are looked at, which is where boilerplate lives, so the cost per file is small and fixed.
+    // A run of boilerplate lines is only cut if it starts within RUN_GAP_MAX lines of the start
+    // of the file, or of the run cut before it, so code shared deeper in files is left alone.
+    // Each distinct run of boilerplate lines that was cut out is kept once in distinctText().
+    class BoilerplateFinder
+    {
+      public:
+        static const std::size_t LINES_MAX;
+        static const std::size_t WINDOW_LINES;
+
+        // shorter windows are too likely to repeat by chance, like a few closing braces
+        static const std::size_t WINDOW_SIZE_MIN;
+
+        // how many lines can come before a run that is cut, like a shebang or a blank line
+        static const std::size_t RUN_GAP_MAX;
+
+        // when there are more windows than this, those only seen once are forgotten
+        static const std::size_t WINDOW_COUNT_MAX;
+
+        explicit BoilerplateFinder(const std::size_t FILE_COUNT_MIN = 8);
+
+        BoilerplateFinder(const BoilerplateFinder &) = delete;
+        BoilerplateFinder(BoilerplateFinder &&) = delete;
+        BoilerplateFinder & operator=(const BoilerplateFinder &) = delete;
+        BoilerplateFinder & operator=(BoilerplateFinder &&) = delete;
+
+        // how much of the start of a file is looked at, the first LINES_MAX lines of it, so a
+        // file too big to hold only needs this much of it held to be learned and stripped
+        static std::size_t scanSize(const char * const BEGIN, const std::size_t SIZE);
+
+        // counts the windows at the start of one file
+        void learn(const char * const BEGIN, const std::size_t SIZE);
+
+        // sets text to the file without the runs of boilerplate lines at its start, and sets
+        // strippedText to just those lines, so they can still be counted as lines
+        void strip(
+            const char * const BEGIN,
+            const std::size_t SIZE,
+            std::string & text,
+            std::string & strippedText);
+
+        inline const std::string & distinctText() const { return m_distinctText; }
+        inline std::size_t distinctLineCount() const { return m_distinctLineCount; }
+        inline std::size_t knownWindowCount() const { return m_knownWindowCount; }
+        inline std::size_t strippedFileCount() const { return m_strippedFileCount; }
+        inline std::size_t strippedLineCount() const { return m_strippedLineCount; }
+
+      private:
+        // Responsible for counting how many files one window was found in.
+        struct Window
+        {
+            std::uint64_t hash = 0; // zero for an empty slot
+            std::size_t fileCount = 0;
+            std::size_t lastFileNumber = 0;
+        };
+
+        // fills m_lineStarts, m_lineHashes, and m_windowHashes for the start of one file
+        void scan(const char * const BEGIN, const std::size_t SIZE);
+
+        static std::uint64_t hashLine(const char * const BEGIN, const std::size_t SIZE);
+
+        bool isKnown(const std::uint64_t WINDOW_HASH) const;
+
+        // m_windows is one flat open addressing table, since a node per window was most of the
+        // time spent, returns the slot that holds WINDOW_HASH or the empty slot where it would go
+        std::size_t findSlot(const std::uint64_t WINDOW_HASH) const;
+
+        // rebuilds m_windows with SLOT_COUNT slots and only the windows in FILE_COUNT_MIN files
+        void rebuildWindows(const std::size_t SLOT_COUNT, const std::size_t FILE_COUNT_MIN);
+
+        void forgetRareWindows();
+
+      private:
+        const std::size_t M_FILE_COUNT_MIN;
+        std::vector<Window> m_windows;
+        std::size_t m_windowCount;
+        std::size_t m_fileNumber;
+        std::size_t m_knownWindowCount;
+        std::set<std::uint64_t> m_distinctRunHashes;
+        std::string m_distinctText;
+        std::size_t m_distinctLineCount;
+        std::size_t m_strippedFileCount;
+        std::size_t m_strippedLineCount;
+
+        // m_lineStarts has one more entry than m_lineHashes, where the last line scanned ends
+        std::vector<std::size_t> m_lineStarts;
+        std::vector<std::uint64_t> m_lineHashes;
+
+        // the file last learned, until the next strip()
+        const char * m_scannedBeginPtr;
+        std::size_t m_scannedSize;
+
+        // zero for windows too short to ever be boilerplate
+        std::vector<std::uint64_t> m_windowHashes;
+
+        // how many files each window was in, as of learning the file last learned
+        std::vector<std::size_t> m_windowFileCounts;
+
+        std::vector<char> m_isLineCovered;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_BOILERPLATEFINDER_HPP_INCLUDED
@@ -0,0 +1,186 @@
+#ifndef WORDSTACKER_BOUNDEDQUEUE_HPP_INCLUDED
+#define WORDSTACKER_BOUNDEDQUEUE_HPP_INCLUDED
+//
+// bounded-queue.hpp
+//
+#include <atomic>
+#include <chrono>
+#include <cstddef> //for std::size_t
+#include <cstdint>
+#include <memory>
+#include <thread>
+#include <utility>
+
+namespace word_stacker
+{
+
+    // Responsible for passing work between pipeline stages through a fixed size lock-free ring.
+    // Any number of threads may push or pop (Dmitry Vyukov's bounded MPMC design).  The blocking
+    // push() is what applies backpressure:  a fast producer waits until a slow consumer catches up.
+    template <typename T>
+    class BoundedQueue
+    {
+      public:
+        explicit BoundedQueue(const std::size_t CAPACITY_MIN)
+            : M_MASK(roundUpToPowerOfTwo(CAPACITY_MIN) - 1)
+            , m_cellsUPtr(std::make_unique<Cell[]>(M_MASK + 1))
+            , m_pushPos(0)
+            , m_popPos(0)
+            , m_isClosed(false)
+        {
+            for (std::size_t i(0); i <= M_MASK; ++i)
+            {
+                m_cellsUPtr[i].sequence.store(i, std::memory_order_relaxed);
+            }
+        }
+
+        BoundedQueue(const BoundedQueue &) = delete;
+        BoundedQueue(BoundedQueue &&) = delete;
+        BoundedQueue & operator=(const BoundedQueue &) = delete;
+        BoundedQueue & operator=(BoundedQueue &&) = delete;
+
+        inline std::size_t capacity() const { return (M_MASK + 1); }
+
+        bool tryPush(T & value)
+        {
+            auto pos{ m_pushPos.load(std::memory_order_relaxed) };
+
+            for (;;)
+            {
+                auto & cell{ m_cellsUPtr[pos & M_MASK] };
+                auto const SEQUENCE{ cell.sequence.load(std::memory_order_acquire) };
+                auto const DIFF{ static_cast<std::intptr_t>(SEQUENCE) -
+                                 static_cast<std::intptr_t>(pos) };
+
+                if (0 == DIFF)
+                {
+                    if (m_pushPos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+                    {
+                        cell.value = std::move(value);
+                        cell.sequence.store((pos + 1), std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (DIFF < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_pushPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        bool tryPop(T & value)
+        {
+            auto pos{ m_popPos.load(std::memory_order_relaxed) };
+
+            for (;;)
+            {
+                auto & cell{ m_cellsUPtr[pos & M_MASK] };
+                auto const SEQUENCE{ cell.sequence.load(std::memory_order_acquire) };
+                auto const DIFF{ static_cast<std::intptr_t>(SEQUENCE) -
+                                 static_cast<std::intptr_t>(pos + 1) };
+
+                if (0 == DIFF)
+                {
+                    if (m_popPos.compare_exchange_weak(pos, (pos + 1), std::memory_order_relaxed))
+                    {
+                        value = std::move(cell.value);
+                        cell.sequence.store((pos + M_MASK + 1), std::memory_order_release);
+                        return true;
+                    }
+                }
+                else if (DIFF < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = m_popPos.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        // waits while the queue is full, returns false only if the queue was closed first
+        bool push(T value)
+        {
+            for (std::size_t attempt(0); tryPush(value) == false; ++attempt)
+            {
+                if (isClosed())
+                {
+                    return false;
+                }
+
+                backoff(attempt);
+            }
+
+            return true;
+        }
+
+        // waits while the queue is empty, returns false once it is both closed and drained
+        bool pop(T & value)
+        {
+            for (std::size_t attempt(0); tryPop(value) == false; ++attempt)
+            {
+                if (isClosed())
+                {
+                    // anything pushed before close() must still be handed out
+                    return tryPop(value);
+                }
+
+                backoff(attempt);
+            }
+
+            return true;
+        }
+
+        inline void close() { m_isClosed.store(true, std::memory_order_release); }
+        inline bool isClosed() const { return m_isClosed.load(std::memory_order_acquire); }
+
+      private:
+        static std::size_t roundUpToPowerOfTwo(const std::size_t NUMBER)
+        {
+            std::size_t result{ 2 };
+            while (result < NUMBER)
+            {
+                result <<= 1;
+            }
+
+            return result;
+        }
+
+        // spin briefly, then yield, then sleep so that a stalled stage costs no cpu
+        static void backoff(const std::size_t ATTEMPT)
+        {
+            if (ATTEMPT < 16)
+            {
+                return;
+            }
+            else if (ATTEMPT < 64)
+            {
+                std::this_thread::yield();
+            }
+            else
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+        }
+
+        struct Cell
+        {
+            std::atomic<std::size_t> sequence{ 0 };
+            T value{};
+        };
+
+        const std::size_t M_MASK;
+        std::unique_ptr<Cell[]> m_cellsUPtr;
+        alignas(64) std::atomic<std::size_t> m_pushPos;
+        alignas(64) std::atomic<std::size_t> m_popPos;
+        alignas(64) std::atomic<bool> m_isClosed;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_BOUNDEDQUEUE_HPP_INCLUDED
@@ -0,0 +1,78 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// concurrent-count-table.cpp
+//
+#include "concurrent-count-table.hpp"
+
+namespace word_stacker
+{
+
+    std::size_t ConcurrentCountTable::roundUpToPowerOfTwo(const std::size_t NUMBER)
+    {
+        std::size_t result{ 1 };
+        while (result < NUMBER)
+        {
+            result <<= 1;
+        }
+
+        return result;
+    }
+
+    ConcurrentCountTable::ConcurrentCountTable(const std::size_t SHARD_COUNT_MIN)
+        : M_SHARD_MASK(roundUpToPowerOfTwo(SHARD_COUNT_MIN) - 1)
+        , m_shardsUPtr(std::make_unique<Shard[]>(M_SHARD_MASK + 1))
+    {}
+
+    void ConcurrentCountTable::increment(const std::string & WORD, const std::size_t AMOUNT)
+    {
+        // the low bits pick the bucket inside each unordered_map, so use the high bits here
+        auto const HASH{ std::hash<std::string>()(WORD) };
+        auto & shard{ m_shardsUPtr[(HASH >> 20) & M_SHARD_MASK] };
+
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.counts[WORD] += AMOUNT;
+    }
+
+    std::size_t ConcurrentCountTable::size() const
+    {
+        std::size_t sum{ 0 };
+        for (std::size_t i(0); i <= M_SHARD_MASK; ++i)
+        {
+            sum += m_shardsUPtr[i].counts.size();
+        }
+
+        return sum;
+    }
+
+    void ConcurrentCountTable::forEach(
+        const std::function<void(const std::string & WORD, const std::size_t COUNT)> & CALLBACK)
+        const
+    {
+        for (std::size_t i(0); i <= M_SHARD_MASK; ++i)
+        {
+            for (auto const & PAIR : m_shardsUPtr[i].counts)
+            {
+                CALLBACK(PAIR.first, PAIR.second);
+            }
+        }
+    }
+
+    void ConcurrentCountTable::forEachLocked(
+        const std::function<void(const std::string & WORD, const std::size_t COUNT)> & CALLBACK)
+        const
+    {
+        for (std::size_t i(0); i <= M_SHARD_MASK; ++i)
+        {
+            auto & shard{ m_shardsUPtr[i] };
+
+            std::lock_guard<std::mutex> lock(shard.mutex);
+
+            for (auto const & PAIR : shard.counts)
+            {
+                CALLBACK(PAIR.first, PAIR.second);
+            }
+        }
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,59 @@
+#ifndef WORDSTACKER_CONCURRENTCOUNTTABLE_HPP_INCLUDED
+#define WORDSTACKER_CONCURRENTCOUNTTABLE_HPP_INCLUDED
+//
+// concurrent-count-table.hpp
+//
+#include <cstddef> //for std::size_t
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+namespace word_stacker
+{
+
+    // Responsible for counting words from many threads at once in one shared table.  The table is
+    // lock-striped:  words are spread over shards by hash and each shard has its own mutex, so
+    // threads only contend when they hit the same shard at the same time.  This trades some lock
+    // traffic for not keeping a full copy of the vocabulary per thread and not merging them later.
+    class ConcurrentCountTable
+    {
+      public:
+        explicit ConcurrentCountTable(const std::size_t SHARD_COUNT_MIN = 256);
+
+        void increment(const std::string & WORD, const std::size_t AMOUNT = 1);
+
+        // not safe to call while other threads are still calling increment()
+        std::size_t size() const;
+
+        // not safe to call while other threads are still calling increment()
+        void forEach(
+            const std::function<void(const std::string & WORD, const std::size_t COUNT)> &
+                CALLBACK) const;
+
+        // safe to call while other threads are still calling increment(), since each shard is
+        // locked while it is visited, but the counts are only a snapshot of each shard in turn
+        void forEachLocked(
+            const std::function<void(const std::string & WORD, const std::size_t COUNT)> &
+                CALLBACK) const;
+
+        inline std::size_t shardCount() const { return (M_SHARD_MASK + 1); }
+
+      private:
+        static std::size_t roundUpToPowerOfTwo(const std::size_t NUMBER);
+
+        // aligned so that two shards never share a cache line
+        struct alignas(64) Shard
+        {
+            std::mutex mutex{};
+            std::unordered_map<std::string, std::size_t> counts{};
+        };
+
+        const std::size_t M_SHARD_MASK;
+        std::unique_ptr<Shard[]> m_shardsUPtr;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_CONCURRENTCOUNTTABLE_HPP_INCLUDED
@@ -0,0 +1,497 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// directory-walker.cpp
+//
+#include "assert-or-throw.hpp"
+#include "directory-walker.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__linux__)
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#endif
+
+namespace word_stacker
+{
+
+    DirectoryWalker::DirectoryWalker(const bool WILL_HONOR_IGNORE_FILES)
+#if defined(__linux__)
+        : M_IS_COUNTING_SYSCALLS(true)
+#else
+        : M_IS_COUNTING_SYSCALLS(false)
+#endif
+        , M_WILL_HONOR_IGNORE_FILES(WILL_HONOR_IGNORE_FILES)
+        , m_directoryCount(0)
+        , m_fileCount(0)
+        , m_loopCount(0)
+        , m_syscallCount(0)
+        , m_filesystemSyscallEstimate(0)
+        , m_ignoredDirectoryCount(0)
+        , m_ignoredFileCount(0)
+        , m_ignoredByteCount(0)
+        , m_ignoreLevels()
+        , m_visited()
+        , m_buffer()
+    {}
+
+    bool DirectoryWalker::isIgnored(const std::string & PATH, const bool IS_DIRECTORY) const
+    {
+        for (auto iter{ m_ignoreLevels.rbegin() }; iter != m_ignoreLevels.rend(); ++iter)
+        {
+            auto const & PREFIX{ iter->prefix };
+
+            if (PATH.compare(0, PREFIX.size(), PREFIX) != 0)
+            {
+                continue;
+            }
+
+            auto const MATCH{ iter->rules.match(PATH.substr(PREFIX.size()), IS_DIRECTORY) };
+
+            if (MATCH != IgnoreMatch::None)
+            {
+                return (IgnoreMatch::Ignore == MATCH);
+            }
+        }
+
+        return false;
+    }
+
+    bool DirectoryWalker::pushIgnoreLevel(
+        const int DIR_FD,
+        const std::string & PATH_PREFIX,
+        const bool HAS_GITIGNORE,
+        const bool HAS_IGNORE)
+    {
+        IgnoreLevel level;
+        level.prefix = PATH_PREFIX;
+
+        // rules in .ignore come after, so they win over those in .gitignore
+        if (HAS_GITIGNORE)
+        {
+            level.rules.parse(readIgnoreFile(DIR_FD, PATH_PREFIX, ".gitignore"));
+        }
+
+        if (HAS_IGNORE)
+        {
+            level.rules.parse(readIgnoreFile(DIR_FD, PATH_PREFIX, ".ignore"));
+        }
+
+        if (level.rules.empty())
+        {
+            return false;
+        }
+
+        m_ignoreLevels.push_back(level);
+        return true;
+    }
+
+#if defined(__linux__)
+    bool DirectoryWalker::markVisited(const std::uint64_t DEVICE, const std::uint64_t INODE)
+    {
+        return m_visited.insert(std::make_pair(DEVICE, INODE)).second;
+    }
+
+    std::size_t DirectoryWalker::absoluteComponentCount(const std::string & PATH)
+    {
+        std::string absolutePath{ PATH };
+
+        if (PATH.empty() || (PATH.front() != '/'))
+        {
+            std::vector<char> cwd(4096, 0);
+
+            ++m_syscallCount;
+            if (getcwd(cwd.data(), cwd.size()) != nullptr)
+            {
+                absolutePath = std::string(cwd.data()) + '/' + PATH;
+            }
+        }
+
+        std::size_t count{ 0 };
+        std::size_t begin{ 0 };
+
+        while (begin < absolutePath.size())
+        {
+            auto end{ absolutePath.find('/', begin) };
+
+            if (std::string::npos == end)
+            {
+                end = absolutePath.size();
+            }
+
+            auto const LENGTH{ end - begin };
+
+            if ((2 == LENGTH) && (absolutePath.compare(begin, LENGTH, "..") == 0))
+            {
+                count -= std::min(count, std::size_t(1));
+            }
+            else if ((LENGTH > 0) && !((1 == LENGTH) && ('.' == absolutePath[begin])))
+            {
+                ++count;
+            }
+
+            begin = (end + 1);
+        }
+
+        return count;
+    }
+
+    void DirectoryWalker::walk(
+        const std::string & PATH,
+        const FilterCallback_t & IS_WANTED,
+        const FileCallback_t & ON_FILE)
+    {
+        struct stat status;
+
+        ++m_syscallCount;
+        auto const STAT_RESULT{ fstatat(AT_FDCWD, PATH.c_str(), &status, 0) };
+
+        M_LOG_AND_ASSERT_OR_THROW(
+            (STAT_RESULT == 0),
+            "word_stacker::DirectoryWalker::walk(path=\"" << PATH << "\") failed to stat:  "
+                                                          << std::strerror(errno));
+
+        auto const COMPONENT_COUNT{ absoluteComponentCount(PATH) };
+        m_filesystemSyscallEstimate += (COMPONENT_COUNT + 2);
+
+        if (S_ISDIR(status.st_mode))
+        {
+            walkDirectory(AT_FDCWD, PATH, PATH, COMPONENT_COUNT, IS_WANTED, ON_FILE);
+        }
+        else if (S_ISREG(status.st_mode))
+        {
+            ++m_fileCount;
+
+            if (IS_WANTED(PATH))
+            {
+                ON_FILE(PATH);
+            }
+        }
+    }
+
+    std::string DirectoryWalker::readIgnoreFile(
+        const int DIR_FD, const std::string &, const std::string & NAME)
+    {
+        ++m_syscallCount;
+        auto const FILE_FD{ openat(DIR_FD, NAME.c_str(), O_RDONLY | O_CLOEXEC) };
+
+        if (FILE_FD < 0)
+        {
+            return "";
+        }
+
+        std::string text;
+        char chunk[4096];
+
+        for (;;)
+        {
+            ++m_syscallCount;
+            auto const SIZE{ read(FILE_FD, chunk, sizeof(chunk)) };
+
+            if (SIZE <= 0)
+            {
+                break;
+            }
+
+            text.append(chunk, static_cast<std::size_t>(SIZE));
+        }
+
+        ++m_syscallCount;
+        close(FILE_FD);
+        return text;
+    }
+
+    void DirectoryWalker::walkDirectory(
+        const int PARENT_FD,
+        const std::string & NAME,
+        const std::string & PATH,
+        const std::size_t COMPONENT_COUNT,
+        const FilterCallback_t & IS_WANTED,
+        const FileCallback_t & ON_FILE)
+    {
+        ++m_syscallCount;
+        auto const DIR_FD{ openat(PARENT_FD, NAME.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC) };
+
+        M_LOG_AND_ASSERT_OR_THROW(
+            (DIR_FD >= 0),
+            "word_stacker::DirectoryWalker::walkDirectory(path=\""
+                << PATH << "\") failed to open that directory:  " << std::strerror(errno));
+
+        struct Entry
+        {
+            std::uint64_t inode = 0;
+            unsigned char type = DT_UNKNOWN;
+            std::string name{};
+        };
+
+        std::vector<Entry> entries;
+        bool hasGitignore{ false };
+        bool hasIgnore{ false };
+        bool hasIgnoreLevel{ false };
+
+        try
+        {
+            struct stat status;
+
+            ++m_syscallCount;
+            M_LOG_AND_ASSERT_OR_THROW(
+                (fstat(DIR_FD, &status) == 0),
+                "word_stacker::DirectoryWalker::walkDirectory(path=\""
+                    << PATH << "\") failed to stat that directory:  " << std::strerror(errno));
+
+            // a symlink back up the tree leads to a directory already walked
+            if (markVisited(status.st_dev, status.st_ino) == false)
+            {
+                ++m_loopCount;
+                ++m_syscallCount;
+                close(DIR_FD);
+                return;
+            }
+
+            ++m_directoryCount;
+
+            // std::filesystem opens, reads, and closes each directory the same way
+            m_filesystemSyscallEstimate += 2;
+
+            m_buffer.resize(32 * 1024);
+
+            for (;;)
+            {
+                ++m_syscallCount;
+                ++m_filesystemSyscallEstimate;
+                auto const SIZE{ getdents64(DIR_FD, m_buffer.data(), m_buffer.size()) };
+
+                M_LOG_AND_ASSERT_OR_THROW(
+                    (SIZE >= 0),
+                    "word_stacker::DirectoryWalker::walkDirectory(path=\""
+                        << PATH << "\") failed to read that directory:  " << std::strerror(errno));
+
+                if (0 == SIZE)
+                {
+                    break;
+                }
+
+                for (long offset(0); offset < SIZE;)
+                {
+                    auto const * const DIRENT_PTR{ reinterpret_cast<const dirent64 *>(
+                        m_buffer.data() + offset) };
+
+                    offset += DIRENT_PTR->d_reclen;
+
+                    if ((std::strcmp(DIRENT_PTR->d_name, ".") == 0) ||
+                        (std::strcmp(DIRENT_PTR->d_name, "..") == 0))
+                    {
+                        continue;
+                    }
+
+                    // ignore files are seen here for free, so only those that exist are opened
+                    if (std::strcmp(DIRENT_PTR->d_name, ".gitignore") == 0)
+                    {
+                        hasGitignore = true;
+                    }
+                    else if (std::strcmp(DIRENT_PTR->d_name, ".ignore") == 0)
+                    {
+                        hasIgnore = true;
+                    }
+
+                    entries.push_back(
+                        Entry{ DIRENT_PTR->d_ino, DIRENT_PTR->d_type, DIRENT_PTR->d_name });
+                }
+            }
+
+            // reading in inode order keeps the disk head moving in one direction
+            std::sort(
+                std::begin(entries), std::end(entries), [](const Entry & A, const Entry & B) {
+                    return (A.inode < B.inode);
+                });
+
+            auto const PATH_PREFIX{ ((PATH.back() == '/') ? PATH : (PATH + '/')) };
+
+            if (M_WILL_HONOR_IGNORE_FILES && (hasGitignore || hasIgnore))
+            {
+                hasIgnoreLevel = pushIgnoreLevel(DIR_FD, PATH_PREFIX, hasGitignore, hasIgnore);
+            }
+
+            // canonical() then is_directory() and is_regular_file() on every entry
+            m_filesystemSyscallEstimate += (entries.size() * (COMPONENT_COUNT + 3));
+
+            for (auto & entry : entries)
+            {
+                // only symlinks, and filesystems that don't fill in d_type, cost another stat
+                if ((DT_LNK == entry.type) || (DT_UNKNOWN == entry.type))
+                {
+                    ++m_syscallCount;
+                    if (fstatat(DIR_FD, entry.name.c_str(), &status, 0) != 0)
+                    {
+                        // a dangling symlink
+                        continue;
+                    }
+
+                    if (S_ISDIR(status.st_mode))
+                    {
+                        entry.type = DT_DIR;
+                    }
+                    else if (S_ISREG(status.st_mode))
+                    {
+                        entry.type = DT_REG;
+                    }
+                }
+
+                auto const ENTRY_PATH{ PATH_PREFIX + entry.name };
+
+                if (DT_DIR == entry.type)
+                {
+                    if (M_WILL_HONOR_IGNORE_FILES &&
+                        ((entry.name == ".git") || isIgnored(ENTRY_PATH, true)))
+                    {
+                        ++m_ignoredDirectoryCount;
+                        continue;
+                    }
+
+                    walkDirectory(
+                        DIR_FD, entry.name, ENTRY_PATH, (COMPONENT_COUNT + 1), IS_WANTED, ON_FILE);
+                }
+                else if (DT_REG == entry.type)
+                {
+                    ++m_fileCount;
+
+                    if (IS_WANTED(ENTRY_PATH) == false)
+                    {
+                        continue;
+                    }
+
+                    if (isIgnored(ENTRY_PATH, false))
+                    {
+                        ++m_ignoredFileCount;
+
+                        // only the files that would have been parsed cost a stat for their size
+                        ++m_syscallCount;
+                        if (fstatat(DIR_FD, entry.name.c_str(), &status, 0) == 0)
+                        {
+                            m_ignoredByteCount += static_cast<std::size_t>(status.st_size);
+                        }
+
+                        continue;
+                    }
+
+                    ON_FILE(ENTRY_PATH);
+                }
+            }
+        }
+        catch (...)
+        {
+            if (hasIgnoreLevel)
+            {
+                m_ignoreLevels.pop_back();
+            }
+
+            close(DIR_FD);
+            throw;
+        }
+
+        if (hasIgnoreLevel)
+        {
+            m_ignoreLevels.pop_back();
+        }
+
+        ++m_syscallCount;
+        close(DIR_FD);
+    }
+#else
+    void DirectoryWalker::walk(
+        const std::string & PATH,
+        const FilterCallback_t & IS_WANTED,
+        const FileCallback_t & ON_FILE)
+    {
+        walkFilesystem(PATH, true, IS_WANTED, ON_FILE);
+    }
+
+    std::string DirectoryWalker::readIgnoreFile(
+        const int, const std::string & PATH_PREFIX, const std::string & NAME)
+    {
+        std::ifstream file(PATH_PREFIX + NAME, std::ios::binary);
+
+        if (file.is_open() == false)
+        {
+            return "";
+        }
+
+        std::ostringstream ss;
+        ss << file.rdbuf();
+        return ss.str();
+    }
+
+    void DirectoryWalker::walkFilesystem(
+        const std::string & PATH_STR,
+        const bool IS_ROOT,
+        const FilterCallback_t & IS_WANTED,
+        const FileCallback_t & ON_FILE)
+    {
+        namespace fs = std::filesystem;
+
+        auto const PATH{ fs::canonical(fs::path(PATH_STR)) };
+
+        if (fs::is_directory(PATH))
+        {
+            ++m_directoryCount;
+
+            auto const PATH_PREFIX{ PATH.string() + '/' };
+
+            auto const HAS_IGNORE_LEVEL{ (
+                M_WILL_HONOR_IGNORE_FILES &&
+                pushIgnoreLevel(
+                    -1,
+                    PATH_PREFIX,
+                    fs::exists(PATH / ".gitignore"),
+                    fs::exists(PATH / ".ignore"))) };
+
+            fs::directory_iterator end_iter;
+            for (fs::directory_iterator iter(PATH); iter != end_iter; ++iter)
+            {
+                auto const & CHILD_PATH{ iter->path() };
+
+                if (M_WILL_HONOR_IGNORE_FILES && fs::is_directory(CHILD_PATH) &&
+                    ((CHILD_PATH.filename() == ".git") || isIgnored(CHILD_PATH.string(), true)))
+                {
+                    ++m_ignoredDirectoryCount;
+                    continue;
+                }
+
+                walkFilesystem(CHILD_PATH.string(), false, IS_WANTED, ON_FILE);
+            }
+
+            if (HAS_IGNORE_LEVEL)
+            {
+                m_ignoreLevels.pop_back();
+            }
+        }
+        else if (fs::is_regular_file(PATH))
+        {
+            ++m_fileCount;
+
+            if (IS_WANTED(PATH.string()) == false)
+            {
+                return;
+            }
+
+            if ((IS_ROOT == false) && isIgnored(PATH.string(), false))
+            {
+                ++m_ignoredFileCount;
+                m_ignoredByteCount += static_cast<std::size_t>(fs::file_size(PATH));
+                return;
+            }
+
+            ON_FILE(PATH.string());
+        }
+    }
+#endif
+
+} // namespace word_stacker
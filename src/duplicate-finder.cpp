@@ -0,0 +1,302 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// duplicate-finder.cpp
+//
+#include "duplicate-finder.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+namespace word_stacker
+{
+
+    DuplicateFinder::DuplicateFinder()
+        : m_buckets()
+        , m_contentCount(0)
+        , m_duplicateCount(0)
+        , m_duplicateByteCount(0)
+        , m_hashCount(0)
+        , m_rereadCount(0)
+        , m_unreadCount(0)
+        , m_buffer()
+    {}
+
+    FoundContent DuplicateFinder::find(
+        const std::string & PATH, const char * const BEGIN, const std::size_t SIZE)
+    {
+        auto & bucket{ m_buckets[SIZE] };
+
+        if (isFirstOfSize(bucket, PATH, SIZE))
+        {
+            FoundContent found;
+            found.index = bucket.firstIndex;
+            return found;
+        }
+
+        ++m_hashCount;
+        return findHash(bucket, hash(BEGIN, SIZE), SIZE);
+    }
+
+    FoundContent DuplicateFinder::findUnread(const std::string & PATH, const std::size_t SIZE)
+    {
+        ++m_unreadCount;
+
+        auto & bucket{ m_buckets[SIZE] };
+
+        if (isFirstOfSize(bucket, PATH, SIZE))
+        {
+            FoundContent found;
+            found.index = bucket.firstIndex;
+            return found;
+        }
+
+        Hash fileHash;
+
+        // a file that cannot be hashed is never matched, so it is counted like any other
+        if (hashFile(PATH, SIZE, fileHash) == false)
+        {
+            FoundContent found;
+            found.index = m_contentCount++;
+            return found;
+        }
+
+        ++m_hashCount;
+        return findHash(bucket, fileHash, SIZE);
+    }
+
+    bool DuplicateFinder::isFirstOfSize(
+        SizeBucket & bucket, const std::string & PATH, const std::size_t SIZE)
+    {
+        if (bucket.indexes.empty() && (bucket.isFirstUnhashed == false))
+        {
+            bucket.isFirstUnhashed = true;
+            bucket.firstPath = PATH;
+            bucket.firstIndex = m_contentCount++;
+            return true;
+        }
+
+        if (bucket.isFirstUnhashed)
+        {
+            hashFirst(bucket, SIZE);
+        }
+
+        return false;
+    }
+
+    FoundContent
+        DuplicateFinder::findHash(SizeBucket & bucket, const Hash & HASH, const std::size_t SIZE)
+    {
+        FoundContent found;
+
+        auto const RESULT{ bucket.indexes.emplace(HASH, m_contentCount) };
+
+        found.index = RESULT.first->second;
+
+        if (RESULT.second)
+        {
+            ++m_contentCount;
+        }
+        else
+        {
+            found.isDuplicate = true;
+            ++m_duplicateCount;
+            m_duplicateByteCount += SIZE;
+        }
+
+        return found;
+    }
+
+    void DuplicateFinder::hashFirst(SizeBucket & bucket, const std::size_t SIZE)
+    {
+        bucket.isFirstUnhashed = false;
+
+        ++m_rereadCount;
+
+        Hash firstHash;
+        auto const WAS_HASHED{ hashFile(bucket.firstPath, SIZE, firstHash) };
+        bucket.firstPath.clear();
+
+        if (WAS_HASHED)
+        {
+            ++m_hashCount;
+            bucket.indexes.emplace(firstHash, bucket.firstIndex);
+        }
+    }
+
+    bool DuplicateFinder::hashFile(const std::string & PATH, const std::size_t SIZE, Hash & result)
+    {
+        std::ifstream file(PATH, std::ios::binary);
+
+        if (file.is_open() == false)
+        {
+            return false;
+        }
+
+        const std::size_t CHUNK_SIZE{ 64 * 1024 };
+        m_buffer.resize(CHUNK_SIZE);
+
+        HashState state;
+
+        // reads past SIZE, to notice if the file grew since it was found
+        while (file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size())) ||
+               (file.gcount() > 0))
+        {
+            hashAdd(state, m_buffer.data(), static_cast<std::size_t>(file.gcount()));
+
+            if (state.size > SIZE)
+            {
+                return false;
+            }
+        }
+
+        if (state.size != SIZE)
+        {
+            return false;
+        }
+
+        result = hashFinish(state);
+        return true;
+    }
+
+    DuplicateFinder::Hash DuplicateFinder::hash(const char * const BEGIN, const std::size_t SIZE)
+    {
+        HashState state;
+        hashAdd(state, BEGIN, SIZE);
+        return hashFinish(state);
+    }
+
+    void DuplicateFinder::hashAdd(
+        HashState & state, const char * const BEGIN, const std::size_t SIZE)
+    {
+        std::size_t offset{ 0 };
+
+        // a block left incomplete by the last piece is finished first
+        if (state.tailSize > 0)
+        {
+            auto const FILL_SIZE{ std::min((16 - state.tailSize), SIZE) };
+            std::memcpy((state.tail + state.tailSize), BEGIN, FILL_SIZE);
+            state.tailSize += FILL_SIZE;
+            offset = FILL_SIZE;
+
+            if (state.tailSize == 16)
+            {
+                hashBlock(state, state.tail);
+                state.tailSize = 0;
+            }
+        }
+
+        for (; (offset + 16) <= SIZE; offset += 16)
+        {
+            hashBlock(state, reinterpret_cast<const unsigned char *>(BEGIN + offset));
+        }
+
+        if (offset < SIZE)
+        {
+            state.tailSize = (SIZE - offset);
+            std::memcpy(state.tail, (BEGIN + offset), state.tailSize);
+        }
+
+        state.size += SIZE;
+    }
+
+    void DuplicateFinder::hashBlock(HashState & state, const unsigned char * const BLOCK)
+    {
+        const std::uint64_t C1{ 0x87c37b91114253d5ULL };
+        const std::uint64_t C2{ 0x4cf5ad432745937fULL };
+
+        std::uint64_t k1{ 0 };
+        std::uint64_t k2{ 0 };
+        std::memcpy(&k1, BLOCK, 8);
+        std::memcpy(&k2, (BLOCK + 8), 8);
+
+        auto & h1{ state.h1 };
+        auto & h2{ state.h2 };
+
+        k1 *= C1;
+        k1 = rotateLeft(k1, 31);
+        k1 *= C2;
+        h1 ^= k1;
+
+        h1 = rotateLeft(h1, 27);
+        h1 += h2;
+        h1 = ((h1 * 5) + 0x52dce729);
+
+        k2 *= C2;
+        k2 = rotateLeft(k2, 33);
+        k2 *= C1;
+        h2 ^= k2;
+
+        h2 = rotateLeft(h2, 31);
+        h2 += h1;
+        h2 = ((h2 * 5) + 0x38495ab5);
+    }
+
+    DuplicateFinder::Hash DuplicateFinder::hashFinish(const HashState & STATE)
+    {
+        const std::uint64_t C1{ 0x87c37b91114253d5ULL };
+        const std::uint64_t C2{ 0x4cf5ad432745937fULL };
+
+        auto h1{ STATE.h1 };
+        auto h2{ STATE.h2 };
+
+        if (STATE.tailSize > 0)
+        {
+            // zero padding the tail gives the same result as the byte by byte switch
+            unsigned char tail[16] = { 0 };
+            std::memcpy(tail, STATE.tail, STATE.tailSize);
+
+            std::uint64_t k1{ 0 };
+            std::uint64_t k2{ 0 };
+            std::memcpy(&k1, tail, 8);
+            std::memcpy(&k2, (tail + 8), 8);
+
+            if (STATE.tailSize > 8)
+            {
+                k2 *= C2;
+                k2 = rotateLeft(k2, 33);
+                k2 *= C1;
+                h2 ^= k2;
+            }
+
+            k1 *= C1;
+            k1 = rotateLeft(k1, 31);
+            k1 *= C2;
+            h1 ^= k1;
+        }
+
+        h1 ^= STATE.size;
+        h2 ^= STATE.size;
+
+        h1 += h2;
+        h2 += h1;
+
+        h1 = finalMix(h1);
+        h2 = finalMix(h2);
+
+        h1 += h2;
+        h2 += h1;
+
+        Hash result;
+        result.low = h1;
+        result.high = h2;
+        return result;
+    }
+
+    std::uint64_t DuplicateFinder::rotateLeft(const std::uint64_t X, const int BITS)
+    {
+        return ((X << BITS) | (X >> (64 - BITS)));
+    }
+
+    std::uint64_t DuplicateFinder::finalMix(std::uint64_t x)
+    {
+        x ^= (x >> 33);
+        x *= 0xff51afd7ed558ccdULL;
+        x ^= (x >> 33);
+        x *= 0xc4ceb9fe1a85ec53ULL;
+        x ^= (x >> 33);
+        return x;
+    }
+
+} // namespace word_stacker
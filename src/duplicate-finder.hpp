@@ -0,0 +1,125 @@
+#ifndef WORDSTACKER_DUPLICATEFINDER_HPP_INCLUDED
+#define WORDSTACKER_DUPLICATEFINDER_HPP_INCLUDED
+//
+// duplicate-finder.hpp
+//
+#include <cstddef> //for std::size_t
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for wrapping what DuplicateFinder knows about the contents of one file.
+    struct FoundContent
+    {
+        // the same for every file with the same contents, counting up from zero
+        std::size_t index = 0;
+
+        // true if an earlier file had the same contents
+        bool isDuplicate = false;
+    };
+
+    // Responsible for recognizing files that are byte-for-byte copies of a file already seen.
+    // Sizes are compared first and only files that share a size with another are hashed, so a
+    // run without duplicates hashes almost nothing.  The first file of each size is not hashed
+    // until a second one of that size shows up, and then it is read again from disk, which is
+    // cheap since it was just read.  Contents are told apart by size and a 128-bit hash only.
+    // Files too big to hold in memory go through the same size check, and when they need a hash
+    // they are read from disk in chunks, so the hash is the same as if they were held whole.
+    class DuplicateFinder
+    {
+      public:
+        DuplicateFinder();
+
+        DuplicateFinder(const DuplicateFinder &) = delete;
+        DuplicateFinder(DuplicateFinder &&) = delete;
+        DuplicateFinder & operator=(const DuplicateFinder &) = delete;
+        DuplicateFinder & operator=(DuplicateFinder &&) = delete;
+
+        FoundContent
+            find(const std::string & PATH, const char * const BEGIN, const std::size_t SIZE);
+
+        // for a file of SIZE bytes that is not held in memory, it is read only if it needs a hash
+        FoundContent findUnread(const std::string & PATH, const std::size_t SIZE);
+
+        inline std::size_t contentCount() const { return m_contentCount; }
+        inline std::size_t duplicateCount() const { return m_duplicateCount; }
+        inline std::size_t duplicateByteCount() const { return m_duplicateByteCount; }
+        inline std::size_t hashCount() const { return m_hashCount; }
+        inline std::size_t rereadCount() const { return m_rereadCount; }
+        inline std::size_t unreadCount() const { return m_unreadCount; }
+
+      private:
+        struct Hash
+        {
+            bool operator<(const Hash & OTHER) const
+            {
+                return ((low < OTHER.low) || ((low == OTHER.low) && (high < OTHER.high)));
+            }
+
+            std::uint64_t low = 0;
+            std::uint64_t high = 0;
+        };
+
+        // Responsible for the MurmurHash3 x64 128 of contents given in pieces of any size.
+        struct HashState
+        {
+            std::uint64_t h1 = 0;
+            std::uint64_t h2 = 0;
+            std::size_t size = 0;
+
+            // the start of a block that is not complete yet
+            unsigned char tail[16] = { 0 };
+            std::size_t tailSize = 0;
+        };
+
+        // Responsible for every distinct content of one size.
+        struct SizeBucket
+        {
+            std::map<Hash, std::size_t> indexes{};
+
+            // the first file of this size, until another of this size needs it hashed
+            bool isFirstUnhashed = false;
+            std::string firstPath{};
+            std::size_t firstIndex = 0;
+        };
+
+        // returns true if PATH is the first of SIZE, which is not hashed yet
+        bool isFirstOfSize(SizeBucket & bucket, const std::string & PATH, const std::size_t SIZE);
+
+        FoundContent findHash(SizeBucket & bucket, const Hash & HASH, const std::size_t SIZE);
+
+        // hashes the first file of BUCKET by reading it again, if that fails it is never matched
+        void hashFirst(SizeBucket & bucket, const std::size_t SIZE);
+
+        // reads PATH in chunks, returns false if it could not be read or is no longer SIZE bytes
+        bool hashFile(const std::string & PATH, const std::size_t SIZE, Hash & result);
+
+        // MurmurHash3 x64 128
+        static Hash hash(const char * const BEGIN, const std::size_t SIZE);
+
+        static void hashAdd(HashState & state, const char * const BEGIN, const std::size_t SIZE);
+        static void hashBlock(HashState & state, const unsigned char * const BLOCK);
+        static Hash hashFinish(const HashState & STATE);
+
+        static std::uint64_t rotateLeft(const std::uint64_t X, const int BITS);
+        static std::uint64_t finalMix(std::uint64_t x);
+
+      private:
+        std::unordered_map<std::size_t, SizeBucket> m_buckets;
+        std::size_t m_contentCount;
+        std::size_t m_duplicateCount;
+        std::size_t m_duplicateByteCount;
+        std::size_t m_hashCount;
+        std::size_t m_rereadCount;
+        std::size_t m_unreadCount;
+        std::vector<char> m_buffer;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_DUPLICATEFINDER_HPP_INCLUDED
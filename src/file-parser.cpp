@@ -4,33 +4,70 @@
 // file-parser.cpp
 //
 #include "assert-or-throw.hpp"
+#include "boilerplate-finder.hpp"
+#include "bounded-queue.hpp"
+#include "concurrent-count-table.hpp"
+#include "directory-walker.hpp"
+#include "duplicate-finder.hpp"
 #include "file-parser.hpp"
+#include "file-reader.hpp"
+#include "parse-progress.hpp"
+#include "streaming-tokenizer.hpp"
 #include "strings.hpp"
+#include "tokenize-policy.hpp"
 #include "word-count-stats.hpp"
 #include "word-list.hpp"
 
-#include <boost/algorithm/algorithm.hpp>
-#include <boost/algorithm/string.hpp>
-
 #include <algorithm>
 #include <bitset>
 #include <cmath>
+#include <exception>
 #include <filesystem>
 #include <fstream>
 #include <map>
+#include <memory>
+#include <mutex>
 #include <sstream>
+#include <thread>
 #include <vector>
 
 namespace word_stacker
 {
 
+    const std::size_t FileParser::STREAM_CHUNK_SIZE{ 64 * 1024 };
+    const std::size_t FileParser::BINARY_SNIFF_SIZE{ 8 * 1024 };
+    const std::size_t FileParser::BOILERPLATE_WARMUP_FILE_COUNT{ 64 };
+    const std::size_t FileParser::LONG_LINE_FILE_COUNT{ 3 };
+
+    void StageTimes::add(const StageTimes & OTHER)
+    {
+        total += OTHER.total;
+        starved += OTHER.starved;
+        blocked += OTHER.blocked;
+        threadCount += OTHER.threadCount;
+    }
+
+    float StageTimes::ratio(const Duration_t D) const
+    {
+        if (total.count() <= 0)
+        {
+            return 0.0f;
+        }
+
+        return static_cast<float>(
+            static_cast<double>(D.count()) / static_cast<double>(total.count()));
+    }
+
     FileParser::FileParser(
         ReportMaker & reportMaker,
         const ArgsParser & ARGS,
         const WordList & COMMON_WORDS,
         const WordList & IGNORED_WORDS,
-        const WordList & FLAGGED_WORDS)
+        const WordList & FLAGGED_WORDS,
+        ParseProgress * const PROGRESS_PTR)
         : m_wordCounts()
+        , m_commentWordCounts()
+        , m_stringWordCounts()
         , m_lineCount(0)
         , m_unCLineCount(0)
         , m_singleCount(0)
@@ -38,7 +75,43 @@ namespace word_stacker
         , m_fileCount(0)
         , m_dirCount(0)
         , m_flaggedCount(0)
-        , m_lengthCountMap()
+        , m_walkedFileCount(0)
+        , m_walkLoopCount(0)
+        , m_walkSyscallCount(0)
+        , m_walkSyscallEstimate(0)
+        , m_overlongCount(0)
+        , m_splitIdentifierCount(0)
+        , m_ignoredDirCount(0)
+        , m_ignoredFileCount(0)
+        , m_ignoredByteCount(0)
+        , m_binaryFileCount(0)
+        , m_binaryByteCount(0)
+        , m_duplicateContentCount(0)
+        , m_duplicateCount(0)
+        , m_duplicateByteCount(0)
+        , m_duplicateReuseCount(0)
+        , m_duplicateHashCount(0)
+        , m_duplicateRereadCount(0)
+        , m_duplicateUnreadCount(0)
+        , m_boilerplateAction()
+        , m_boilerplateWindowCount(0)
+        , m_boilerplateFileCount(0)
+        , m_boilerplateLineCount(0)
+        , m_boilerplateDistinctLineCount(0)
+        , m_lineMetrics()
+        , m_lineMetricsSummary()
+        , m_extensionLineMetrics()
+        , m_fileLineSummaries()
+        , m_discoveryTimes()
+        , m_readingTimes()
+        , m_tokenizingTimes()
+        , m_aggregationTime(StageTimes::Duration_t::zero())
+        , m_countTableShardCount(0)
+        , m_countTableEntryCount(0)
+        , m_kernelName()
+        , m_kernelBenchmarks()
+        , m_vocabularyStats()
+        , m_progressPtr(PROGRESS_PTR)
     {
         M_LOG_AND_ASSERT_OR_THROW(
             ((ARGS.parseAs() == ParseType::Text) || (ARGS.parseAs() == ParseType::Code)),
@@ -47,13 +120,37 @@ namespace word_stacker
 
         ParseSupplies parseSupplies(reportMaker, ARGS, COMMON_WORDS, IGNORED_WORDS, FLAGGED_WORDS);
 
-        auto const & PATHS{ ARGS.parsePaths() };
-        for (auto const & PATH : PATHS)
+        runPipeline(parseSupplies);
+
+        if ((nullptr != m_progressPtr) && m_progressPtr->isCancelled())
         {
-            parseDirectoryOrFile(parseSupplies, PATH);
+            return;
         }
 
-        if (parseSupplies.m_wordCountMap.empty())
+        auto & counts{ parseSupplies.m_counts };
+        m_lineCount = counts.lineCount;
+        m_unCLineCount = counts.unCLineCount;
+        m_singleCount = counts.singleCount;
+        m_ignoredCount = counts.ignoredCount;
+        m_fileCount = counts.fileCount;
+        m_flaggedCount = counts.flaggedCount;
+        m_overlongCount = counts.overlongCount;
+        m_splitIdentifierCount = counts.splitIdentifierCount;
+        m_lineMetrics = std::move(counts.lineMetrics);
+        m_lineMetricsSummary = m_lineMetrics.summarize();
+        m_extensionLineMetrics = std::move(counts.extensionLineMetrics);
+        m_fileLineSummaries = std::move(counts.fileLineSummaries);
+
+        std::sort(
+            std::begin(m_fileLineSummaries),
+            std::end(m_fileLineSummaries),
+            [](const FileLineSummary & A, const FileLineSummary & B) {
+                return (A.summary.lengthP99 > B.summary.lengthP99);
+            });
+
+        auto const & PATHS{ ARGS.parsePaths() };
+
+        if (counts.wordCountMap.empty())
         {
             std::cerr << "  Failed to parse any words from the following paths:\n";
 
@@ -67,13 +164,19 @@ namespace word_stacker
             exit(EXIT_FAILURE);
         }
 
-        m_wordCounts.reserve(parseSupplies.m_wordCountMap.size());
-        for (auto const & PAIR : parseSupplies.m_wordCountMap)
+        m_wordCounts.reserve(counts.wordCountMap.size());
+        for (auto const & PAIR : counts.wordCountMap)
         {
             m_wordCounts.emplace_back(PAIR.first, PAIR.second);
         }
 
-        parseSupplies.m_wordCountMap.clear();
+        counts.wordCountMap.clear();
+
+        if (ARGS.willSplitVocabularies())
+        {
+            makeVocabulary(counts, Vocabulary::Comments, m_commentWordCounts);
+            makeVocabulary(counts, Vocabulary::Strings, m_stringWordCounts);
+        }
 
         auto const STATS{ Statistics::calculate(
             m_wordCounts, "Frequency List\t", parseSupplies.m_reportMaker.frequencyListLength()) };
@@ -81,6 +184,49 @@ namespace word_stacker
         logStatistics(parseSupplies.m_reportMaker, STATS);
     }
 
+    const WordCountVec_t & FileParser::words(const Vocabulary::Enum VOCABULARY) const
+    {
+        if (VOCABULARY == Vocabulary::Comments)
+        {
+            return m_commentWordCounts;
+        }
+
+        if (VOCABULARY == Vocabulary::Strings)
+        {
+            return m_stringWordCounts;
+        }
+
+        return m_wordCounts;
+    }
+
+    void FileParser::makeVocabulary(
+        ParseCounts & counts, const Vocabulary::Enum VOCABULARY, WordCountVec_t & wordCounts)
+    {
+        auto & wordCountMap{ counts.wordCountMapFor(VOCABULARY) };
+
+        wordCounts.reserve(wordCountMap.size());
+        for (auto const & PAIR : wordCountMap)
+        {
+            wordCounts.emplace_back(PAIR.first, PAIR.second);
+        }
+
+        wordCountMap.clear();
+
+        const std::size_t TOP_WORD_COUNT{ 5 };
+        auto const STATS{ Statistics::calculate(wordCounts, "", TOP_WORD_COUNT) };
+
+        std::ostringstream ss;
+        ss << Vocabulary::toString(VOCABULARY) << " Vocabulary\t=" << STATS.unique
+           << " unique of " << STATS.sum << " words";
+
+        for (std::size_t i(0); i < STATS.freqs.size(); ++i)
+        {
+            ss << ((0 == i) ? ", top " : ", ") << STATS.freqs[i];
+        }
+
+        m_vocabularyStats.push_back(ss.str());
+    }
+
     const WordCount & FileParser::wordCountObj(const std::size_t INDEX) const
     {
         M_LOG_AND_ASSERT_OR_THROW(
@@ -91,36 +237,697 @@ namespace word_stacker
         return m_wordCounts[INDEX];
     }
 
-    void FileParser::parseDirectoryOrFile(ParseSupplies & supplies, const std::string & PATH_STR)
+    void FileParser::runPipeline(ParseSupplies & supplies)
     {
-        namespace fs = std::filesystem;
+        using Clock_t = std::chrono::steady_clock;
+
+        BoundedQueue<std::string> pathQueue(4096);
+
+        // small because each entry holds a whole file, which bounds memory use
+        BoundedQueue<FileContents> contentsQueue(64);
+
+        // the first exception from any stage is kept and all the queues are closed so that every
+        // other stage finishes early, then it is re-thrown once all threads are joined
+        std::mutex errorMutex;
+        std::exception_ptr errorPtr;
+
+        auto const ABORT{ [&]() {
+            std::lock_guard<std::mutex> lock(errorMutex);
+
+            if (!errorPtr)
+            {
+                errorPtr = std::current_exception();
+            }
+
+            pathQueue.close();
+            contentsQueue.close();
+        } };
 
-        auto const PATH{ fs::canonical(fs::path(PATH_STR)) };
+        // stage one, path discovery
+        auto const WILL_BENCHMARK_KERNELS{ supplies.M_ARGS.willBenchmarkKernels() };
+        StrVec_t benchmarkPaths;
 
-        if (fs::is_directory(PATH))
+        std::thread discoveryThread([&]() {
+            auto const START{ Clock_t::now() };
+
+            try
+            {
+                DirectoryWalker walker(!supplies.M_ARGS.willParseAllFiles());
+
+                for (auto const & PATH : supplies.M_ARGS.parsePaths())
+                {
+                    walker.walk(
+                        PATH,
+                        [&](const std::string & FILE_PATH) {
+                            // once cancelled the rest of the walk finds nothing
+                            if ((nullptr != m_progressPtr) && m_progressPtr->isCancelled())
+                            {
+                                return false;
+                            }
+
+                            return doesFilenameMatchParseType(supplies, FILE_PATH);
+                        },
+                        [&](const std::string & FILE_PATH) {
+                            if (WILL_BENCHMARK_KERNELS)
+                            {
+                                benchmarkPaths.push_back(FILE_PATH);
+                            }
+
+                            if (nullptr != m_progressPtr)
+                            {
+                                m_progressPtr->addFoundFile();
+                            }
+
+                            auto const WAIT_START{ Clock_t::now() };
+                            pathQueue.push(FILE_PATH);
+                            m_discoveryTimes.blocked += (Clock_t::now() - WAIT_START);
+                        });
+                }
+
+                m_dirCount = walker.directoryCount();
+                m_walkedFileCount = walker.fileCount();
+                m_walkLoopCount = walker.loopCount();
+                m_ignoredDirCount = walker.ignoredDirectoryCount();
+                m_ignoredFileCount = walker.ignoredFileCount();
+                m_ignoredByteCount = walker.ignoredByteCount();
+
+                if (walker.isCountingSyscalls())
+                {
+                    m_walkSyscallCount = walker.syscallCount();
+                    m_walkSyscallEstimate = walker.filesystemSyscallEstimate();
+                }
+            }
+            catch (...)
+            {
+                ABORT();
+            }
+
+            pathQueue.close();
+
+            if (nullptr != m_progressPtr)
+            {
+                m_progressPtr->finishDiscovery();
+            }
+
+            m_discoveryTimes.total = (Clock_t::now() - START);
+            m_discoveryTimes.threadCount = 1;
+        });
+
+        // stage two, file reading
+        auto wasReadingWithIoUring{ false };
+        std::size_t batchedReadCount{ 0 };
+        std::size_t blockingReadCount{ 0 };
+        std::size_t tooBigReadCount{ 0 };
+        auto const WILL_SKIP_BINARY{ !supplies.M_ARGS.willParseAllFiles() };
+
+        // skipping duplicates wins if both are set
+        auto const WILL_SKIP_DUPLICATES{ supplies.M_ARGS.willSkipDuplicates() };
+
+        auto const WILL_REUSE_DUPLICATES{ (
+            !WILL_SKIP_DUPLICATES && supplies.M_ARGS.willReuseDuplicates()) };
+
+        DuplicateFinder duplicateFinder;
+
+        // content index to how many more copies were found, only for contents whose counts
+        // are cached by the tokenizer that parsed them
+        std::map<std::size_t, std::size_t> cachedContentCopyCounts;
+
+        // excluding boilerplate wins if both are set
+        auto const WILL_EXCLUDE_BOILERPLATE{ supplies.M_ARGS.willExcludeBoilerplate() };
+
+        auto const WILL_COUNT_BOILERPLATE_ONCE{ (
+            !WILL_EXCLUDE_BOILERPLATE && supplies.M_ARGS.willCountBoilerplateOnce()) };
+
+        auto const WILL_STRIP_BOILERPLATE{ (
+            WILL_EXCLUDE_BOILERPLATE || WILL_COUNT_BOILERPLATE_ONCE) };
+
+        BoilerplateFinder boilerplateFinder;
+
+        std::thread readingThread([&]() {
+            auto const START{ Clock_t::now() };
+
+            auto const PUSH{ [&](FileContents && contents) {
+                auto const WAIT_START{ Clock_t::now() };
+                contentsQueue.push(std::move(contents));
+                m_readingTimes.blocked += (Clock_t::now() - WAIT_START);
+            } };
+
+            // files that are never tokenized are done as soon as they are skipped
+            auto const SKIP{ [&](const std::size_t SIZE) {
+                if (nullptr != m_progressPtr)
+                {
+                    m_progressPtr->addDoneFile(SIZE);
+                }
+            } };
+
+            // returns true if the file was a copy that is skipped, otherwise contents is set to
+            // cache the counts of the copy that is parsed for the rest
+            auto const SKIP_IF_DUPLICATE{ [&](FileContents & contents,
+                                              const FoundContent & FOUND,
+                                              const std::size_t SIZE) {
+                if (FOUND.isDuplicate == false)
+                {
+                    return false;
+                }
+
+                if (WILL_SKIP_DUPLICATES)
+                {
+                    SKIP(SIZE);
+                    return true;
+                }
+
+                auto const CACHED_ITER{ cachedContentCopyCounts.find(FOUND.index) };
+
+                if (CACHED_ITER != std::end(cachedContentCopyCounts))
+                {
+                    ++CACHED_ITER->second;
+                    SKIP(SIZE);
+                    return true;
+                }
+
+                // the first copy was parsed before it was known to have copies, so this one is
+                // parsed and cached for the rest
+                contents.willCacheCounts = true;
+                contents.contentIndex = FOUND.index;
+                cachedContentCopyCounts.emplace(FOUND.index, 0);
+                return false;
+            } };
+
+            std::vector<FileContents> heldContents;
+            auto isHoldingBack{ WILL_STRIP_BOILERPLATE };
+
+            // returns true if contents was held back to be stripped once more files are learned
+            auto const LEARN_AND_STRIP{ [&](FileContents & contents,
+                                            const char * const BEGIN,
+                                            const std::size_t SIZE) {
+                boilerplateFinder.learn(BEGIN, SIZE);
+
+                if (isHoldingBack)
+                {
+                    contents.text.assign(BEGIN, SIZE);
+                    heldContents.push_back(std::move(contents));
+                    return true;
+                }
+
+                boilerplateFinder.strip(BEGIN, SIZE, contents.text, contents.strippedText);
+                return false;
+            } };
+
+            auto const RELEASE_HELD{ [&]() {
+                isHoldingBack = false;
+
+                for (auto & held : heldContents)
+                {
+                    std::string text;
+                    boilerplateFinder.strip(
+                        held.text.data(), held.text.size(), text, held.strippedText);
+                    held.text.swap(text);
+                    PUSH(std::move(held));
+                }
+
+                heldContents.clear();
+            } };
+
+            try
+            {
+                FileReader reader;
+                wasReadingWithIoUring = reader.isUsingIoUring();
+
+                reader.read(
+                    [&](std::string & path) {
+                        auto const WAIT_START{ Clock_t::now() };
+                        auto const WAS_POPPED{ pathQueue.pop(path) };
+                        m_readingTimes.starved += (Clock_t::now() - WAIT_START);
+                        return WAS_POPPED;
+                    },
+                    [&](const std::string & PATH,
+                        const char * const BEGIN,
+                        const std::size_t SIZE) {
+                        if (WILL_SKIP_BINARY && doesContentLookBinary(BEGIN, SIZE))
+                        {
+                            ++m_binaryFileCount;
+                            m_binaryByteCount += SIZE;
+                            SKIP(SIZE);
+                            return;
+                        }
+
+                        FileContents contents{ PATH, "", true };
+
+                        if ((WILL_SKIP_DUPLICATES || WILL_REUSE_DUPLICATES) &&
+                            SKIP_IF_DUPLICATE(
+                                contents, duplicateFinder.find(PATH, BEGIN, SIZE), SIZE))
+                        {
+                            return;
+                        }
+
+                        if (WILL_STRIP_BOILERPLATE)
+                        {
+                            if (LEARN_AND_STRIP(contents, BEGIN, SIZE))
+                            {
+                                if (heldContents.size() >= BOILERPLATE_WARMUP_FILE_COUNT)
+                                {
+                                    RELEASE_HELD();
+                                }
+
+                                return;
+                            }
+                        }
+                        else
+                        {
+                            contents.text.assign(BEGIN, SIZE);
+                        }
+
+                        PUSH(std::move(contents));
+                    },
+                    [&](const std::string & PATH,
+                        const char * const BEGIN,
+                        const std::size_t SIZE) {
+                        if (WILL_SKIP_BINARY && doesContentLookBinary(BEGIN, SIZE))
+                        {
+                            // only the start was read, so ask for the real size
+                            std::error_code errorCode;
+                            auto const FILE_SIZE{ std::filesystem::file_size(PATH, errorCode) };
+
+                            ++m_binaryFileCount;
+
+                            m_binaryByteCount +=
+                                ((errorCode) ? SIZE : static_cast<std::size_t>(FILE_SIZE));
+
+                            SKIP((errorCode) ? SIZE : static_cast<std::size_t>(FILE_SIZE));
+                            return;
+                        }
+
+                        FileContents contents{ PATH, "", false };
+
+                        // only the start was read, so the size is needed to check for copies
+                        if (WILL_SKIP_DUPLICATES || WILL_REUSE_DUPLICATES)
+                        {
+                            std::error_code errorCode;
+                            auto const FILE_SIZE{ std::filesystem::file_size(PATH, errorCode) };
+
+                            if (!errorCode &&
+                                SKIP_IF_DUPLICATE(
+                                    contents,
+                                    duplicateFinder.findUnread(
+                                        PATH, static_cast<std::size_t>(FILE_SIZE)),
+                                    static_cast<std::size_t>(FILE_SIZE)))
+                            {
+                                return;
+                            }
+                        }
+
+                        // only the first lines can be boilerplate, and those were read already
+                        if (WILL_STRIP_BOILERPLATE)
+                        {
+                            contents.streamOffset = BoilerplateFinder::scanSize(BEGIN, SIZE);
+
+                            if (LEARN_AND_STRIP(contents, BEGIN, contents.streamOffset))
+                            {
+                                if (heldContents.size() >= BOILERPLATE_WARMUP_FILE_COUNT)
+                                {
+                                    RELEASE_HELD();
+                                }
+
+                                return;
+                            }
+                        }
+
+                        PUSH(std::move(contents));
+                    });
+
+                // when there were fewer files than the warmup
+                RELEASE_HELD();
+
+                batchedReadCount = reader.batchedCount();
+                blockingReadCount = reader.blockingCount();
+                tooBigReadCount = reader.tooBigCount();
+            }
+            catch (...)
+            {
+                ABORT();
+            }
+
+            contentsQueue.close();
+            m_readingTimes.total = (Clock_t::now() - START);
+            m_readingTimes.threadCount = 1;
+        });
+
+        // stage three, tokenizing
+        auto const KERNEL{ selectKernel(supplies, supplies.M_ARGS.willUseConcurrentCounts()) };
+        m_kernelName = KERNEL.name;
+
+        // counts that are cached must be kept per file, never in the shared table
+        auto const CACHING_KERNEL{ selectKernel(supplies, false) };
+        auto const PARSE_TYPE{ supplies.M_ARGS.parseAs() };
+
+        std::unique_ptr<ConcurrentCountTable> sharedCountTableUPtr;
+
+        if (supplies.M_ARGS.willUseConcurrentCounts())
+        {
+            sharedCountTableUPtr = std::make_unique<ConcurrentCountTable>();
+        }
+
+        auto const HARDWARE_THREAD_COUNT{ static_cast<std::size_t>(
+            std::thread::hardware_concurrency()) };
+
+        auto const TOKENIZER_THREAD_COUNT{ (
+            (HARDWARE_THREAD_COUNT > 1) ? (HARDWARE_THREAD_COUNT - 1) : std::size_t(1)) };
+
+        std::vector<ParseCounts> threadCounts(TOKENIZER_THREAD_COUNT);
+        std::vector<StageTimes> threadTimes(TOKENIZER_THREAD_COUNT);
+
+        // content index to the counts of that file, see FileContents::willCacheCounts
+        std::vector<std::map<std::size_t, ParseCounts>> threadCachedCounts(
+            TOKENIZER_THREAD_COUNT);
+
+        // with a shared table there is only one set of counts, so only one thread publishes
+        if (nullptr != m_progressPtr)
         {
-            ++m_dirCount;
-            fs::directory_iterator end_iter;
-            for (fs::directory_iterator iter(PATH); iter != end_iter; ++iter)
+            m_progressPtr->setSlotCount((sharedCountTableUPtr) ? 1 : TOKENIZER_THREAD_COUNT);
+        }
+
+        std::vector<std::thread> tokenizerThreads;
+
+        for (std::size_t t(0); t < TOKENIZER_THREAD_COUNT; ++t)
+        {
+            tokenizerThreads.emplace_back([&, t]() {
+                auto const START{ Clock_t::now() };
+
+                ParseSupplies threadSupplies(
+                    supplies.m_reportMaker,
+                    supplies.M_ARGS,
+                    supplies.M_COMMON_WORDS,
+                    supplies.M_IGNORED_WORDS,
+                    supplies.M_FLAGGED_WORDS);
+
+                threadSupplies.m_sharedCountTablePtr = sharedCountTableUPtr.get();
+
+                // files too big for the reading stage are streamed from disk here
+                auto const PARSE{ [&](const TokenizeKernel & PARSE_KERNEL,
+                                      ParseSupplies & parseSupplies,
+                                      const FileContents & CONTENTS,
+                                      std::size_t & byteCount) {
+                    if (CONTENTS.isLoaded)
+                    {
+                        countLines(PARSE_TYPE, parseSupplies.m_counts, CONTENTS.strippedText);
+
+                        (this->*PARSE_KERNEL.parseBufferFuncPtr)(
+                            parseSupplies,
+                            CONTENTS.path,
+                            CONTENTS.text.data(),
+                            CONTENTS.text.size());
+
+                        return;
+                    }
+
+                    std::ifstream file;
+                    file.open(CONTENTS.path);
+
+                    M_LOG_AND_ASSERT_OR_THROW(
+                        (file.is_open()),
+                        "word_stacker::FileParser::runPipeline(file_path=\""
+                            << CONTENTS.path << "\") failed to open that file.");
+
+                    countLines(PARSE_TYPE, parseSupplies.m_counts, CONTENTS.strippedText);
+
+                    file.seekg(static_cast<std::streamoff>(CONTENTS.streamOffset));
+
+                    (this->*PARSE_KERNEL.parseStreamFuncPtr)(
+                        parseSupplies, CONTENTS.path, CONTENTS.text, file);
+
+                    // only the progress shown needs the size of a streamed file
+                    if (nullptr != m_progressPtr)
+                    {
+                        std::error_code errorCode;
+                        auto const FILE_SIZE{ std::filesystem::file_size(
+                            CONTENTS.path, errorCode) };
+
+                        byteCount = ((errorCode) ? 0 : static_cast<std::size_t>(FILE_SIZE));
+                    }
+                } };
+
+                try
+                {
+                    for (;;)
+                    {
+                        FileContents contents;
+
+                        auto const WAIT_START{ Clock_t::now() };
+                        auto const WAS_POPPED{ contentsQueue.pop(contents) };
+                        threadTimes[t].starved += (Clock_t::now() - WAIT_START);
+
+                        if (WAS_POPPED == false)
+                        {
+                            break;
+                        }
+
+                        // closing the queues stops every other stage early too
+                        if ((nullptr != m_progressPtr) && m_progressPtr->isCancelled())
+                        {
+                            pathQueue.close();
+                            contentsQueue.close();
+                            break;
+                        }
+
+                        auto byteCount{ contents.text.size() };
+
+                        if (contents.willCacheCounts)
+                        {
+                            ParseSupplies fileSupplies(
+                                supplies.m_reportMaker,
+                                supplies.M_ARGS,
+                                supplies.M_COMMON_WORDS,
+                                supplies.M_IGNORED_WORDS,
+                                supplies.M_FLAGGED_WORDS);
+
+                            PARSE(CACHING_KERNEL, fileSupplies, contents, byteCount);
+
+                            threadSupplies.m_counts.merge(fileSupplies.m_counts);
+
+                            threadCachedCounts[t][contents.contentIndex] =
+                                std::move(fileSupplies.m_counts);
+                        }
+                        else
+                        {
+                            PARSE(KERNEL, threadSupplies, contents, byteCount);
+                        }
+
+                        if (nullptr != m_progressPtr)
+                        {
+                            m_progressPtr->addDoneFile(byteCount);
+
+                            if (sharedCountTableUPtr)
+                            {
+                                if ((0 == t) && m_progressPtr->isPublishDue(t))
+                                {
+                                    m_progressPtr->publish(t, *sharedCountTableUPtr);
+                                }
+                            }
+                            else if (m_progressPtr->isPublishDue(t))
+                            {
+                                m_progressPtr->publish(t, threadSupplies.m_counts.wordCountMap);
+                            }
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    ABORT();
+                }
+
+                threadCounts[t] = std::move(threadSupplies.m_counts);
+                threadTimes[t].total = (Clock_t::now() - START);
+                threadTimes[t].threadCount = 1;
+            });
+        }
+
+        discoveryThread.join();
+        readingThread.join();
+
+        for (auto & thread : tokenizerThreads)
+        {
+            thread.join();
+        }
+
+        if (errorPtr)
+        {
+            std::rethrow_exception(errorPtr);
+        }
+
+        // stage four, count aggregation
+        auto const AGGREGATION_START{ Clock_t::now() };
+
+        for (std::size_t t(0); t < TOKENIZER_THREAD_COUNT; ++t)
+        {
+            m_tokenizingTimes.add(threadTimes[t]);
+            m_countTableEntryCount += threadCounts[t].wordCountMap.size();
+
+            if (supplies.m_counts.wordCountMap.empty())
             {
-                parseDirectoryOrFile(supplies, iter->path().string());
+                supplies.m_counts.wordCountMap.swap(threadCounts[t].wordCountMap);
             }
+
+            supplies.m_counts.merge(threadCounts[t]);
         }
-        else if (fs::is_regular_file(PATH))
+
+        if (sharedCountTableUPtr)
+        {
+            m_countTableShardCount = sharedCountTableUPtr->shardCount();
+            m_countTableEntryCount = sharedCountTableUPtr->size();
+
+            auto & wordCountMap{ supplies.m_counts.wordCountMap };
+            sharedCountTableUPtr->forEach([&](const std::string & WORD, const std::size_t COUNT) {
+                wordCountMap[WORD] += COUNT;
+            });
+        }
+
+        // every copy that was not parsed counts the same as the one that was
+        for (auto const & CACHED_COUNTS : threadCachedCounts)
+        {
+            for (auto const & PAIR : CACHED_COUNTS)
+            {
+                auto const COPY_COUNT{ cachedContentCopyCounts[PAIR.first] };
+
+                if (COPY_COUNT > 0)
+                {
+                    supplies.m_counts.mergeCopies(PAIR.second, COPY_COUNT);
+                    m_duplicateReuseCount += COPY_COUNT;
+                }
+            }
+        }
+
+        // every distinct block of boilerplate cut out of the files is counted here once
+        if (WILL_COUNT_BOILERPLATE_ONCE && !boilerplateFinder.distinctText().empty())
+        {
+            ParseSupplies boilerplateSupplies(
+                supplies.m_reportMaker,
+                supplies.M_ARGS,
+                supplies.M_COMMON_WORDS,
+                supplies.M_IGNORED_WORDS,
+                supplies.M_FLAGGED_WORDS);
+
+            auto const & TEXT{ boilerplateFinder.distinctText() };
+
+            (this->*CACHING_KERNEL.parseBufferFuncPtr)(
+                boilerplateSupplies, "", TEXT.data(), TEXT.size());
+
+            // those lines were already counted in the files they were cut from
+            boilerplateSupplies.m_counts.fileCount = 0;
+            boilerplateSupplies.m_counts.lineCount = 0;
+            boilerplateSupplies.m_counts.unCLineCount = 0;
+            boilerplateSupplies.m_counts.lineMetrics.clear();
+            supplies.m_counts.merge(boilerplateSupplies.m_counts);
+        }
+
+        if (WILL_STRIP_BOILERPLATE)
+        {
+            m_boilerplateAction = ((WILL_EXCLUDE_BOILERPLATE) ? "excluded" : "counted once");
+            m_boilerplateWindowCount = boilerplateFinder.knownWindowCount();
+            m_boilerplateFileCount = boilerplateFinder.strippedFileCount();
+            m_boilerplateLineCount = boilerplateFinder.strippedLineCount();
+            m_boilerplateDistinctLineCount = boilerplateFinder.distinctLineCount();
+        }
+
+        m_duplicateContentCount = duplicateFinder.contentCount();
+        m_duplicateCount = duplicateFinder.duplicateCount();
+        m_duplicateByteCount = duplicateFinder.duplicateByteCount();
+        m_duplicateHashCount = duplicateFinder.hashCount();
+        m_duplicateRereadCount = duplicateFinder.rereadCount();
+        m_duplicateUnreadCount = duplicateFinder.unreadCount();
+
+        m_aggregationTime = (Clock_t::now() - AGGREGATION_START);
+
+        if (wasReadingWithIoUring)
         {
-            if (doesFilenameMatchParseType(supplies, PATH.string()))
+            auto & stream{ supplies.m_reportMaker.miscStream() };
+
+            stream << "Read " << batchedReadCount << " files with io_uring and " << tooBigReadCount
+                   << " too big for one batched read";
+
+            // only when io_uring failed part way
+            if (blockingReadCount > 0)
             {
-                openFileAndParse(supplies, PATH.string());
+                stream << ", then " << blockingReadCount << " without it after it failed";
             }
         }
+
+        if (WILL_BENCHMARK_KERNELS)
+        {
+            benchmarkKernels(supplies, benchmarkPaths, TOKENIZER_THREAD_COUNT);
+        }
+    }
+
+    bool FileParser::doesContentLookBinary(const char * const BEGIN, const std::size_t SIZE)
+    {
+        auto const SAMPLE_SIZE{ std::min(SIZE, BINARY_SNIFF_SIZE) };
+        auto const * const BYTES{ reinterpret_cast<const unsigned char *>(BEGIN) };
+
+        std::size_t invalidCount{ 0 };
+        std::size_t i{ 0 };
+
+        while (i < SAMPLE_SIZE)
+        {
+            auto const BYTE{ BYTES[i] };
+
+            if (0 == BYTE)
+            {
+                return true;
+            }
+
+            if (BYTE < 0x80)
+            {
+                ++i;
+                continue;
+            }
+
+            std::size_t sequenceLength{ 0 };
+
+            if ((BYTE & 0xE0) == 0xC0)
+            {
+                sequenceLength = 2;
+            }
+            else if ((BYTE & 0xF0) == 0xE0)
+            {
+                sequenceLength = 3;
+            }
+            else if ((BYTE & 0xF8) == 0xF0)
+            {
+                sequenceLength = 4;
+            }
+
+            // a sequence cut off by the end of the sample is not held against it
+            if ((sequenceLength > 0) && ((i + sequenceLength) > SAMPLE_SIZE))
+            {
+                break;
+            }
+
+            auto isValid{ (sequenceLength > 0) };
+
+            for (std::size_t s(1); isValid && (s < sequenceLength); ++s)
+            {
+                isValid = ((BYTES[i + s] & 0xC0) == 0x80);
+            }
+
+            if (isValid)
+            {
+                i += sequenceLength;
+            }
+            else
+            {
+                ++invalidCount;
+                ++i;
+            }
+        }
+
+        return ((invalidCount * 10) > SAMPLE_SIZE);
     }
 
     bool FileParser::doesFilenameMatchParseType(
-        ParseSupplies & supplies, const std::string & FILENAME) const
+        const ParseSupplies & SUPPLIES, const std::string & FILENAME) const
     {
         StrVec_t fileExtensions;
 
-        switch (supplies.M_ARGS.parseAs())
+        switch (SUPPLIES.M_ARGS.parseAs())
         {
             case ParseType::Text:
             {
@@ -141,7 +948,7 @@ namespace word_stacker
 
                 fileExtensions = CODE_FILE_EXTENSIONS;
 
-                if (supplies.M_ARGS.willParseHTML())
+                if (SUPPLIES.M_ARGS.willParseHTML())
                 {
                     const StrVec_t HTML_FILE_EXTENSIONS = { ".xslt", ".css",   ".xsl",   ".htm",
                                                             ".html", ".xhtml", ".jhtml", ".phtml",
@@ -173,208 +980,395 @@ namespace word_stacker
         return false;
     }
 
-    void FileParser::openFileAndParse(ParseSupplies & supplies, const std::string & FILE_PATH)
+    template <ParseType::Enum PARSE_TYPE, bool... FLAGS>
+    struct FileParser::KernelSelector
     {
-        std::ifstream file;
-        file.open(FILE_PATH);
-
-        M_LOG_AND_ASSERT_OR_THROW(
-            (file.is_open()),
-            "word_stacker::FileParser::ParseAsText(file_path=\""
-                << FILE_PATH << "\") failed to open that file.");
-
-        try
+        // each call fixes one more flag at compile time, until they are all fixed
+        template <typename... Bools_t>
+        static TokenizeKernel select(const bool FLAG, const Bools_t... REMAINING_FLAGS)
         {
-            switch (supplies.M_ARGS.parseAs())
+            if (FLAG)
             {
-                case ParseType::Text:
-                {
-                    parseFileContentsText(supplies, file);
-                    break;
-                }
-                case ParseType::Code:
-                {
-                    parseFileContentsCode(supplies, file);
-                    break;
-                }
-                case ParseType::Count:
-                default:
-                {
-                    break;
-                }
+                return KernelSelector<PARSE_TYPE, FLAGS..., true>::select(REMAINING_FLAGS...);
+            }
+            else
+            {
+                return KernelSelector<PARSE_TYPE, FLAGS..., false>::select(REMAINING_FLAGS...);
             }
         }
-        catch (...)
+
+        static TokenizeKernel select()
         {
-            file.close();
-            throw;
+            return makeKernel<TokenizePolicy<PARSE_TYPE, FLAGS...>>();
         }
+    };
 
-        file.close();
+    FileParser::TokenizeKernel
+        FileParser::selectKernel(const ParseSupplies & SUPPLIES, const bool IS_SHARED_COUNT)
+    {
+        return selectKernel(
+            SUPPLIES.M_ARGS.parseAs(),
+            (SUPPLIES.M_ARGS.willIgnoreCommonWords() && (SUPPLIES.M_COMMON_WORDS.count() > 0)),
+            (SUPPLIES.M_IGNORED_WORDS.count() > 0),
+            (SUPPLIES.M_FLAGGED_WORDS.count() > 0),
+            IS_SHARED_COUNT,
+            SUPPLIES.M_ARGS.willSplitIdentifiers(),
+            SUPPLIES.M_ARGS.willKeepIdentifiers(),
+            SUPPLIES.M_ARGS.willSplitVocabularies());
     }
 
-    void FileParser::parseFileContentsText(ParseSupplies & supplies, std::ifstream & file)
+    FileParser::TokenizeKernel FileParser::selectKernel(
+        const ParseType::Enum PARSE_TYPE,
+        const bool WILL_SKIP_COMMON,
+        const bool HAS_IGNORED,
+        const bool HAS_FLAGGED,
+        const bool IS_SHARED_COUNT,
+        const bool WILL_SPLIT_IDENTIFIERS,
+        const bool WILL_KEEP_IDENTIFIERS,
+        const bool WILL_SPLIT_VOCABULARIES)
     {
-        ++m_fileCount;
+        // text has no identifiers, comments, or strings, so it has no kernels for them either
+        if (PARSE_TYPE == ParseType::Text)
+        {
+            return KernelSelector<ParseType::Text>::select(
+                WILL_SKIP_COMMON, HAS_IGNORED, HAS_FLAGGED, IS_SHARED_COUNT);
+        }
+        else
+        {
+            return KernelSelector<ParseType::Code>::select(
+                WILL_SKIP_COMMON,
+                HAS_IGNORED,
+                HAS_FLAGGED,
+                IS_SHARED_COUNT,
+                WILL_SPLIT_IDENTIFIERS,
+                (WILL_SPLIT_IDENTIFIERS && WILL_KEEP_IDENTIFIERS),
+                WILL_SPLIT_VOCABULARIES);
+        }
+    }
 
-        const std::string CHARS_TO_KEEP{ "abcedfghijklmnopqrstuvwxyz'-" };
+    template <typename Policy_t>
+    FileParser::TokenizeKernel FileParser::makeKernel()
+    {
+        TokenizeKernel kernel;
+        kernel.name = Policy_t::name();
+        kernel.parseBufferFuncPtr = &FileParser::parseFileContents<Policy_t>;
+        kernel.parseStreamFuncPtr = &FileParser::parseFileContents<Policy_t>;
+        return kernel;
+    }
+
+    template <typename Policy_t>
+    void FileParser::parseFileContents(
+        ParseSupplies & supplies,
+        const std::string & PATH,
+        const std::string & HEAD_TEXT,
+        std::istream & file) const
+    {
+        std::vector<char> chunk(STREAM_CHUNK_SIZE);
+
+        auto wordSink{ [&](const std::string & WORD, const Vocabulary::Enum VOCABULARY) {
+            parseWord<Policy_t>(supplies, WORD, VOCABULARY);
+        } };
+
+        StreamingTokenizer<Policy_t, decltype(wordSink)> tokenizer(supplies.m_counts, wordSink);
 
-        std::string line;
-        while (std::getline(file, line))
+        ++supplies.m_counts.fileCount;
+        tokenizer.feed(HEAD_TEXT.data(), HEAD_TEXT.size());
+
+        while (file.read(chunk.data(), static_cast<std::streamsize>(chunk.size())) ||
+               (file.gcount() > 0))
         {
-            ++m_lineCount;
-            ++m_unCLineCount;
+            tokenizer.feed(chunk.data(), static_cast<std::size_t>(file.gcount()));
+        }
 
-            utilz::replaceAll(line, "\r", "");
-            utilz::replaceAll(line, "\n", "");
+        tokenizer.finish();
+        supplies.m_counts.endFile(PATH);
+    }
 
-            m_lengthCountMap[line.length()]++;
+    template <typename Policy_t>
+    void FileParser::parseFileContents(
+        ParseSupplies & supplies,
+        const std::string & PATH,
+        const char * const BEGIN,
+        const std::size_t SIZE) const
+    {
+        auto wordSink{ [&](const std::string & WORD, const Vocabulary::Enum VOCABULARY) {
+            parseWord<Policy_t>(supplies, WORD, VOCABULARY);
+        } };
 
-            // this appears in lots of poems
-            utilz::replaceAll(line, "--", "-");
+        StreamingTokenizer<Policy_t, decltype(wordSink)> tokenizer(supplies.m_counts, wordSink);
 
-            // use boost here because it handles multi-byte characters so well
-            boost::to_lower(line);
+        ++supplies.m_counts.fileCount;
+        tokenizer.feed(BEGIN, SIZE);
+        tokenizer.finish();
+        supplies.m_counts.endFile(PATH);
+    }
 
-            changeInvalidCharactersToSpaces(line, CHARS_TO_KEEP);
+    void FileParser::countLines(
+        const ParseType::Enum PARSE_TYPE, ParseCounts & counts, const std::string & TEXT)
+    {
+        if (TEXT.empty())
+        {
+            return;
+        }
 
-            utilz::trimWhitespace(line);
+        ParseCounts lineCounts;
+        auto wordSink{ [](const std::string &, const Vocabulary::Enum) {} };
 
-            std::istringstream iss(line);
-            std::string word;
-            while (iss >> word)
-            {
-                utilz::trimIfNot(
-                    word, [](const char CH) { return !((CH == '\'') || (CH == '-')); });
+        if (PARSE_TYPE == ParseType::Text)
+        {
+            StreamingTokenizer<
+                TokenizePolicy<ParseType::Text, false, false, false, false>,
+                decltype(wordSink)>
+                tokenizer(lineCounts, wordSink);
 
-                // remove trailing 's
-                if (word.size() >= 4)
-                {
-                    if ((word[word.size() - 2] == '\'') && (word[word.size() - 1] == 's'))
-                    {
-                        word = word.substr(0, word.size() - 2);
-                    }
-                }
+            tokenizer.feed(TEXT.data(), TEXT.size());
+            tokenizer.finish();
+        }
+        else
+        {
+            StreamingTokenizer<
+                TokenizePolicy<ParseType::Code, false, false, false, false>,
+                decltype(wordSink)>
+                tokenizer(lineCounts, wordSink);
 
-                parseWord(supplies, word);
-            }
+            tokenizer.feed(TEXT.data(), TEXT.size());
+            tokenizer.finish();
         }
+
+        counts.lineCount += lineCounts.lineCount;
+        counts.unCLineCount += lineCounts.unCLineCount;
+        counts.fileLineMetrics.merge(lineCounts.fileLineMetrics);
     }
 
-    void FileParser::parseFileContentsCode(ParseSupplies & supplies, std::ifstream & file)
+    template <typename Policy_t>
+    void FileParser::parseWord(
+        ParseSupplies & supplies,
+        const std::string & WORD,
+        const Vocabulary::Enum VOCABULARY) const
     {
-        ++m_fileCount;
+        auto const LENGTH{ WORD.size() };
 
-        const std::string CHARS_TO_KEEP{
-            "qwertyuiopasdfghjklzxcvbnmQWERTYUIOPASDSFGHJKLZXCVBNM1234567890_"
-        };
+        if (0 == LENGTH)
+        {
+            return;
+        }
 
-        std::string line;
-        while (std::getline(file, line))
+        if (LENGTH == 1)
         {
-            ++m_lineCount;
-            ++m_unCLineCount;
+            if ((Policy_t::M_PARSE_TYPE == ParseType::Text) || (VOCABULARY != Vocabulary::Code))
+            {
+                if ((WORD == "-") || (WORD == "'"))
+                {
+                    return;
+                }
+            }
 
-            utilz::replaceAll(line, "\r", "");
-            utilz::replaceAll(line, "\n", "");
+            ++supplies.m_counts.singleCount;
+        }
 
-            auto const ORIG_LINE_LENGTH{ line.length() };
+        if constexpr (Policy_t::M_HAS_FLAGGED)
+        {
+            if (supplies.M_FLAGGED_WORDS.contains(WORD))
+            {
+                ++supplies.m_counts.flaggedCount;
+            }
+        }
 
-            utilz::trimWhitespace(line);
+        if constexpr (Policy_t::M_WILL_SKIP_COMMON)
+        {
+            if (supplies.M_COMMON_WORDS.contains(WORD))
+            {
+                ++supplies.m_counts.ignoredCount;
+                return;
+            }
+        }
 
-            if (line.empty())
+        if constexpr (Policy_t::M_HAS_IGNORED)
+        {
+            if (supplies.M_IGNORED_WORDS.contains(WORD))
             {
-                continue;
+                ++supplies.m_counts.ignoredCount;
+                return;
             }
+        }
 
-            if (utilz::startsWith(line, "//"))
+        // only the main vocabulary is worth the shared table, the others are always small
+        if constexpr (Policy_t::M_IS_SHARED_COUNT)
+        {
+            if (VOCABULARY == Vocabulary::Code)
             {
-                --m_unCLineCount;
-                continue;
+                supplies.m_sharedCountTablePtr->increment(WORD);
+                return;
             }
-            else
+        }
+
+        supplies.m_counts.wordCountMapFor(VOCABULARY)[WORD]++;
+    }
+
+    void FileParser::benchmarkKernels(
+        const ParseSupplies & SUPPLIES, const StrVec_t & PATHS, const std::size_t THREAD_COUNT)
+    {
+        using Clock_t = std::chrono::steady_clock;
+
+        // read the sample first so that only tokenizing is timed
+        const std::size_t SAMPLE_SIZE_MAX{ 64 * 1024 * 1024 };
+
+        StrVec_t sampleTexts;
+        std::size_t sampleSize{ 0 };
+
+        for (auto const & PATH : PATHS)
+        {
+            if (sampleSize >= SAMPLE_SIZE_MAX)
             {
-                m_lengthCountMap[ORIG_LINE_LENGTH]++;
+                break;
             }
 
-            // remove in-line comments
-            auto const COMMENT_POS{ line.find("//") };
-            if (COMMENT_POS != std::string::npos)
+            std::ifstream file;
+            file.open(PATH, std::ios::binary);
+
+            M_LOG_AND_ASSERT_OR_THROW(
+                (file.is_open()),
+                "word_stacker::FileParser::benchmarkKernels(file_path=\""
+                    << PATH << "\") failed to open that file.");
+
+            std::ostringstream textSS;
+            textSS << file.rdbuf();
+            sampleTexts.push_back(textSS.str());
+            sampleSize += sampleTexts.back().size();
+        }
+
+        if (0 == sampleSize)
+        {
+            return;
+        }
+
+        // every combination of the four flags in TokenizePolicy that only change the speed, the
+        // identifier and vocabulary flags change the words found so those are kept as they are
+        for (unsigned flags(0); flags < 16; ++flags)
+        {
+            auto const KERNEL{ selectKernel(
+                SUPPLIES.M_ARGS.parseAs(),
+                ((flags & 1u) != 0),
+                ((flags & 2u) != 0),
+                ((flags & 4u) != 0),
+                ((flags & 8u) != 0),
+                SUPPLIES.M_ARGS.willSplitIdentifiers(),
+                SUPPLIES.M_ARGS.willKeepIdentifiers(),
+                SUPPLIES.M_ARGS.willSplitVocabularies()) };
+
+            // the same threads as the parse, each with its own counts or all sharing one table,
+            // and the time includes getting them all into one map, as the parse does
+            std::vector<std::unique_ptr<ParseSupplies>> threadSuppliesUPtrs;
+            ConcurrentCountTable sharedCountTable;
+
+            for (std::size_t t(0); t < THREAD_COUNT; ++t)
             {
-                line = line.substr(0, COMMENT_POS);
+                threadSuppliesUPtrs.push_back(std::make_unique<ParseSupplies>(
+                    SUPPLIES.m_reportMaker,
+                    SUPPLIES.M_ARGS,
+                    SUPPLIES.M_COMMON_WORDS,
+                    SUPPLIES.M_IGNORED_WORDS,
+                    SUPPLIES.M_FLAGGED_WORDS));
+
+                threadSuppliesUPtrs.back()->m_sharedCountTablePtr = &sharedCountTable;
             }
 
-            utilz::replaceAll(line, "\\\"", "");
+            auto const START{ Clock_t::now() };
+
+            std::vector<std::thread> threads;
 
-            // remove text in double quotes
-            if (line.find('\"') != std::string::npos)
+            for (std::size_t t(0); t < THREAD_COUNT; ++t)
             {
-                auto isDeletingString{ false };
+                threads.emplace_back([&, t]() {
+                    auto & threadSupplies{ *threadSuppliesUPtrs[t] };
 
-                for (auto iter{ line.begin() }; iter != line.end(); ++iter)
-                {
-                    if ('\"' == *iter)
+                    for (std::size_t i(t); i < sampleTexts.size(); i += THREAD_COUNT)
                     {
-                        *iter = ' ';
-                        isDeletingString = !isDeletingString;
-                    }
+                        auto const & TEXT{ sampleTexts[i] };
 
-                    if (isDeletingString)
-                    {
-                        *iter = ' ';
+                        (this->*KERNEL.parseBufferFuncPtr)(
+                            threadSupplies, "", TEXT.data(), TEXT.size());
                     }
-                }
+                });
+            }
+
+            for (auto & thread : threads)
+            {
+                thread.join();
             }
 
-            changeInvalidCharactersToSpaces(line, CHARS_TO_KEEP);
-            utilz::trimWhitespace(line);
+            ParseCounts counts;
 
-            std::istringstream lineSS(line);
-            std::string word;
-            while (lineSS >> word)
+            for (auto const & THREAD_SUPPLIES_UPTR : threadSuppliesUPtrs)
             {
-                utilz::trimWhitespace(word);
-                parseWord(supplies, word);
+                counts.merge(THREAD_SUPPLIES_UPTR->m_counts);
             }
+
+            sharedCountTable.forEach([&](const std::string & WORD, const std::size_t COUNT) {
+                counts.wordCountMap[WORD] += COUNT;
+            });
+
+            auto const SECONDS{ std::chrono::duration<double>(Clock_t::now() - START).count() };
+
+            auto const MEGABYTES{ static_cast<double>(sampleSize) / (1024.0 * 1024.0) };
+
+            std::ostringstream ss;
+            ss << "Kernel Benchmark\t=" << KERNEL.name << " at "
+               << static_cast<std::size_t>(MEGABYTES / std::max(SECONDS, 0.000001)) << "MB/s over "
+               << sampleTexts.size() << " files with " << THREAD_COUNT << " thread"
+               << ((THREAD_COUNT == 1) ? "" : "s");
+
+            m_kernelBenchmarks.push_back(ss.str());
         }
     }
 
-    void FileParser::parseWord(ParseSupplies & supplies, const std::string & WORD)
+    void FileParser::logLineMetrics(ReportMaker & reportMaker) const
     {
-        auto const LENGTH{ WORD.size() };
-
-        if (0 == LENGTH)
+        if (m_lineMetricsSummary.lineCount == 0)
         {
             return;
         }
 
-        if (LENGTH == 1)
-        {
-            if ((WORD == "-") || (WORD == "'"))
-            {
-                return;
-            }
+        auto const PERCENT{ [](const float RATIO) {
+            return (std::round(RATIO * 1000.0f) / 10.0f);
+        } };
 
-            ++m_singleCount;
-        }
-
-        if (supplies.M_FLAGGED_WORDS.contains(WORD))
-        {
-            ++m_flaggedCount;
-        }
+        auto const & SUMMARY{ m_lineMetricsSummary };
 
-        auto const WILL_SKIP_IGNORED_COMMON{ (
-            supplies.M_ARGS.willIgnoreCommonWords() && supplies.M_COMMON_WORDS.contains(WORD)) };
+        reportMaker.fileStatsStream()
+            << "Line Length Percentiles\t=p50 " << SUMMARY.lengthP50 << ", p95 "
+            << SUMMARY.lengthP95 << ", p99 " << SUMMARY.lengthP99 << ", max "
+            << SUMMARY.lengthMax;
 
-        auto const WILL_SKIP_IGNORED{ supplies.M_IGNORED_WORDS.contains(WORD) };
+        reportMaker.fileStatsStream()
+            << "Lines Longer Than 80/100/120\t=" << PERCENT(SUMMARY.over80Ratio) << "%, "
+            << PERCENT(SUMMARY.over100Ratio) << "%, " << PERCENT(SUMMARY.over120Ratio) << "%";
 
-        if (WILL_SKIP_IGNORED_COMMON || WILL_SKIP_IGNORED)
+        // only worth breaking down if there is more than one kind of file
+        if (m_extensionLineMetrics.size() > 1)
         {
-            ++m_ignoredCount;
+            for (auto const & PAIR : m_extensionLineMetrics)
+            {
+                auto const EXTENSION_SUMMARY{ PAIR.second.summarize() };
+
+                reportMaker.fileStatsStream()
+                    << "Line Length of " << ((PAIR.first.empty()) ? "(none)" : PAIR.first)
+                    << "\t=" << EXTENSION_SUMMARY.lineCount << " lines, p50 "
+                    << EXTENSION_SUMMARY.lengthP50 << ", p99 " << EXTENSION_SUMMARY.lengthP99
+                    << ", " << PERCENT(EXTENSION_SUMMARY.over100Ratio) << "% over 100";
+            }
         }
-        else
+
+        auto const FILE_COUNT{ std::min(LONG_LINE_FILE_COUNT, m_fileLineSummaries.size()) };
+
+        for (std::size_t i(0); i < FILE_COUNT; ++i)
         {
-            supplies.m_wordCountMap[WORD]++;
+            auto const & FILE_LINE_SUMMARY{ m_fileLineSummaries[i] };
+
+            reportMaker.fileStatsStream()
+                << "Long Lines in\t=" << FILE_LINE_SUMMARY.path << ", p99 "
+                << FILE_LINE_SUMMARY.summary.lengthP99 << ", max "
+                << FILE_LINE_SUMMARY.summary.lengthMax;
         }
     }
 
@@ -386,6 +1380,60 @@ namespace word_stacker
         reportMaker.fileStatsStream()
             << m_dirCount << " Director" << ((1 == m_dirCount) ? "y" : "ies") << " Parsed";
 
+        if (m_walkSyscallCount > 0)
+        {
+            auto const FILE_COUNT{ static_cast<float>(
+                std::max(std::size_t(1), m_walkedFileCount)) };
+
+            reportMaker.fileStatsStream()
+                << "Directory Walk Syscalls\t=" << m_walkSyscallCount << ", "
+                << (static_cast<float>(m_walkSyscallCount) / FILE_COUNT)
+                << " per file, instead of about " << m_walkSyscallEstimate << ", "
+                << (static_cast<float>(m_walkSyscallEstimate) / FILE_COUNT)
+                << " per file with std::filesystem";
+        }
+
+        if (m_walkLoopCount > 0)
+        {
+            reportMaker.fileStatsStream()
+                << "Directory Loops Skipped\t=" << m_walkLoopCount << " already walked";
+        }
+
+        if ((m_ignoredDirCount > 0) || (m_ignoredFileCount > 0))
+        {
+            reportMaker.fileStatsStream()
+                << "Skipped by Ignore Files\t=" << m_ignoredDirCount << " directories and "
+                << m_ignoredFileCount << " files of " << m_ignoredByteCount << " bytes";
+        }
+
+        if (m_binaryFileCount > 0)
+        {
+            reportMaker.fileStatsStream() << "Skipped as Binary\t=" << m_binaryFileCount
+                                          << " files of " << m_binaryByteCount << " bytes";
+        }
+
+        if (m_duplicateContentCount > 0)
+        {
+            reportMaker.fileStatsStream()
+                << "Duplicate Files\t=" << m_duplicateCount << " of " << m_duplicateByteCount
+                << " bytes among " << m_duplicateContentCount << " distinct, "
+                << m_duplicateReuseCount << " counted without parsing";
+
+            reportMaker.fileStatsStream()
+                << "Duplicate Hashing\t=" << m_duplicateHashCount << " files hashed, "
+                << m_duplicateRereadCount << " read again, " << m_duplicateUnreadCount
+                << " too big to hold, hashed from disk only when sizes matched";
+        }
+
+        if (!m_boilerplateAction.empty())
+        {
+            reportMaker.fileStatsStream()
+                << "Boilerplate Lines (" << m_boilerplateAction << ")\t=" << m_boilerplateLineCount
+                << " from " << m_boilerplateFileCount << " files, "
+                << m_boilerplateDistinctLineCount << " distinct, " << m_boilerplateWindowCount
+                << " blocks of " << BoilerplateFinder::WINDOW_LINES << " lines known";
+        }
+
         reportMaker.fileStatsStream() << '-';
         reportMaker.fileStatsStream() << "Total Line Count\t=" << m_lineCount;
 
@@ -394,12 +1442,33 @@ namespace word_stacker
             reportMaker.fileStatsStream() << "Line Count Excluding Comments\t=" << m_unCLineCount;
         }
 
+        logLineMetrics(reportMaker);
+
         reportMaker.fileStatsStream() << '-';
         reportMaker.fileStatsStream() << "Single Letter or Number Word Count\t=" << m_singleCount;
         reportMaker.fileStatsStream() << "Ignored Word Count\t=" << m_ignoredCount;
         reportMaker.fileStatsStream() << "Unique Word Count\t=" << STATS.unique;
         reportMaker.fileStatsStream() << "Flagged Word Count\t=" << m_flaggedCount;
+
+        if (m_overlongCount > 0)
+        {
+            reportMaker.fileStatsStream()
+                << "Overlong Word Count (skipped)\t=" << m_overlongCount << " longer than "
+                << TOKENIZER_WORD_LENGTH_MAX;
+        }
+
+        if (m_splitIdentifierCount > 0)
+        {
+            reportMaker.fileStatsStream()
+                << "Split Identifier Count\t=" << m_splitIdentifierCount << " counted by parts";
+        }
+
         reportMaker.fileStatsStream() << "Total Word Count\t=" << STATS.sum;
+
+        for (auto const & VOCABULARY_STR : m_vocabularyStats)
+        {
+            reportMaker.fileStatsStream() << VOCABULARY_STR;
+        }
         reportMaker.fileStatsStream() << '-';
         reportMaker.fileStatsStream() << "Frequency Minimum\t=" << STATS.min;
         reportMaker.fileStatsStream() << "Frequency Average\t=" << STATS.average;
@@ -412,18 +1481,64 @@ namespace word_stacker
         {
             reportMaker.fileStatsStream() << FREQ_STR;
         }
-    }
 
-    void FileParser::changeInvalidCharactersToSpaces(
-        std::string & str, const std::string & CHARS_TO_KEEP) const
-    {
-        for (char & ch : str)
+        auto const PERCENT{ [](const float RATIO) {
+            return static_cast<int>(std::round(RATIO * 100.0f));
+        } };
+
+        auto const MILLISECONDS{ [](const StageTimes::Duration_t D) {
+            return std::chrono::duration_cast<std::chrono::milliseconds>(D).count();
+        } };
+
+        reportMaker.fileStatsStream() << '-';
+
+        reportMaker.fileStatsStream()
+            << "Pipeline Discovery Busy\t=" << PERCENT(m_discoveryTimes.busyRatio()) << "% of "
+            << MILLISECONDS(m_discoveryTimes.total) << "ms";
+
+        reportMaker.fileStatsStream()
+            << "Pipeline Reading Busy\t=" << PERCENT(m_readingTimes.busyRatio()) << "% of "
+            << MILLISECONDS(m_readingTimes.total) << "ms, "
+            << PERCENT(m_readingTimes.ratio(m_readingTimes.starved)) << "% waiting for paths, "
+            << PERCENT(m_readingTimes.ratio(m_readingTimes.blocked))
+            << "% waiting for tokenizers";
+
+        reportMaker.fileStatsStream()
+            << "Pipeline Tokenizing Busy\t=" << PERCENT(m_tokenizingTimes.busyRatio()) << "% of "
+            << MILLISECONDS(m_tokenizingTimes.total) << "ms over "
+            << m_tokenizingTimes.threadCount << " threads, "
+            << PERCENT(m_tokenizingTimes.ratio(m_tokenizingTimes.starved))
+            << "% waiting for reads";
+
+        reportMaker.fileStatsStream()
+            << "Pipeline Aggregation Time\t=" << MILLISECONDS(m_aggregationTime) << "ms";
+
+        if (m_countTableShardCount > 0)
         {
-            if (CHARS_TO_KEEP.find(ch) == std::string::npos)
-            {
-                ch = ' ';
-            }
+            reportMaker.fileStatsStream()
+                << "Count Table\t=Concurrent over " << m_countTableShardCount << " shards";
+        }
+        else
+        {
+            reportMaker.fileStatsStream() << "Count Table\t=Thread-Local then Merged";
+        }
+
+        // how many word/count entries were held before the merge, more than unique means copies
+        reportMaker.fileStatsStream() << "Count Table Entries\t=" << m_countTableEntryCount;
+        reportMaker.fileStatsStream() << "Tokenizer Kernel\t=" << m_kernelName;
+
+        for (auto const & BENCHMARK_STR : m_kernelBenchmarks)
+        {
+            reportMaker.fileStatsStream() << BENCHMARK_STR;
         }
+
+        // a reader stuck on a full queue means the tokenizers can't keep up, and tokenizers stuck
+        // on an empty queue mean the reader can't keep up
+        auto const IS_CPU_BOUND{ m_readingTimes.ratio(m_readingTimes.blocked) >
+                                 m_tokenizingTimes.ratio(m_tokenizingTimes.starved) };
+
+        reportMaker.fileStatsStream()
+            << "Pipeline Bound By\t=" << ((IS_CPU_BOUND) ? "Tokenizing (CPU)" : "Reading (I/O)");
     }
 
 } // namespace word_stacker
@@ -4,12 +4,17 @@
 // file-parser.hpp
 //
 #include "args-parser.hpp"
+#include "parse-counts.hpp"
 #include "parse-type-enum.hpp"
 #include "report-maker.hpp"
+#include "vocabulary-enum.hpp"
 #include "word-count.hpp"
 #include "word-list.hpp"
 
+#include <chrono>
 #include <cstddef> //for std::size_t
+#include <functional>
+#include <istream>
 #include <map>
 #include <sstream>
 #include <string>
@@ -18,10 +23,55 @@
 namespace word_stacker
 {
 
+    class ConcurrentCountTable;
+    class ParseProgress;
     struct FreqStats;
 
-    using WordCountMap_t = std::map<std::string, std::size_t>;
-    using LengthCountMap_t = std::map<std::size_t, std::size_t>;
+    // Responsible for timing one pipeline stage, summed over all of that stage's threads.
+    struct StageTimes
+    {
+        using Duration_t = std::chrono::steady_clock::duration;
+
+        StageTimes()
+            : total(Duration_t::zero())
+            , starved(Duration_t::zero())
+            , blocked(Duration_t::zero())
+            , threadCount(0)
+        {}
+
+        void add(const StageTimes & OTHER);
+
+        // the fraction of total time spent on D, so zero when nothing was timed
+        float ratio(const Duration_t D) const;
+
+        inline float busyRatio() const { return ratio(total - starved - blocked); }
+
+        Duration_t total;
+        Duration_t starved; // waiting on an empty input queue
+        Duration_t blocked; // waiting on a full output queue
+        std::size_t threadCount;
+    };
+
+    // Responsible for carrying one file from the reading stage to the tokenizing stage.  Files
+    // too big to read in one go arrive with isLoaded false, and are read by the tokenizer in
+    // chunks of FileParser::STREAM_CHUNK_SIZE.
+    struct FileContents
+    {
+        std::string path{};
+        std::string text{};
+        bool isLoaded = false;
+
+        // the boilerplate cut out of text, only tokenized for its lines, see countLines()
+        std::string strippedText{};
+
+        // when not isLoaded, text is what was kept of the start of the file, and the rest is
+        // streamed from here
+        std::size_t streamOffset = 0;
+
+        // when reusing duplicates, the counts of the first copy found are kept for the rest
+        bool willCacheCounts = false;
+        std::size_t contentIndex = 0;
+    };
 
     // Responsible for wrapping objects commonly required by the FileParser.
     struct ParseSupplies
@@ -37,29 +87,81 @@ namespace word_stacker
             , M_COMMON_WORDS(COMMON_WORDS)
             , M_IGNORED_WORDS(IGNORED_WORDS)
             , M_FLAGGED_WORDS(FLAGGED_WORDS)
-            , m_wordCountMap()
+            , m_counts()
+            , m_sharedCountTablePtr(nullptr)
         {}
 
+        ParseSupplies(const ParseSupplies &) = delete;
+        ParseSupplies(ParseSupplies &&) = delete;
+        ParseSupplies & operator=(const ParseSupplies &) = delete;
+        ParseSupplies & operator=(ParseSupplies &&) = delete;
+
         ReportMaker & m_reportMaker;
         const ArgsParser & M_ARGS;
         const WordList & M_COMMON_WORDS;
         const WordList & M_IGNORED_WORDS;
         const WordList & M_FLAGGED_WORDS;
-        WordCountMap_t m_wordCountMap;
+        ParseCounts m_counts;
+
+        // when set, words are counted here instead of in m_counts.wordCountMap
+        ConcurrentCountTable * m_sharedCountTablePtr;
     };
 
-    // responsible for parsing files into a sorted vector of word/count pairs.
+    // Responsible for parsing files into a sorted vector of word/count pairs.  The work is split
+    // into pipeline stages that overlap I/O with cpu work:  path discovery, file reading,
+    // tokenizing (one thread per spare core), and finally merging all the counts together.
+    // Tokenizers either count into their own maps that are merged at the end, or all count into
+    // one shared ConcurrentCountTable, see ArgsParser::willUseConcurrentCounts().  The tokenizing
+    // is done by one of several kernels compiled from TokenizePolicy, picked once per run.
     class FileParser
     {
+        using ParseBufferFunc_t = void (FileParser::*)(
+            ParseSupplies &, const std::string &, const char * const, const std::size_t) const;
+
+        using ParseStreamFunc_t = void (FileParser::*)(
+            ParseSupplies &, const std::string &, const std::string &, std::istream &) const;
+
+        // Responsible for wrapping one instantiation of the tokenizing kernel.
+        struct TokenizeKernel
+        {
+            std::string name{};
+            ParseBufferFunc_t parseBufferFuncPtr = nullptr;
+            ParseStreamFunc_t parseStreamFuncPtr = nullptr;
+        };
+
+        template <ParseType::Enum PARSE_TYPE, bool... FLAGS>
+        struct KernelSelector;
+
       public:
+        // how much of a file too big for the reading stage is held in memory at once
+        static const std::size_t STREAM_CHUNK_SIZE;
+
+        // how much of the start of each file is checked to see if it looks binary
+        static const std::size_t BINARY_SNIFF_SIZE;
+
+        // how many files are held back at the start to learn their boilerplate before any is cut
+        static const std::size_t BOILERPLATE_WARMUP_FILE_COUNT;
+
+        // how many of the files with the longest lines are listed in the report
+        static const std::size_t LONG_LINE_FILE_COUNT;
+
+        // when PROGRESS_PTR is not null, other threads can watch the parse through it while
+        // this runs, and can cancel it, which leaves everything here incomplete
         explicit FileParser(
             ReportMaker & reportMaker,
             const ArgsParser & ARGS,
             const WordList & COMMON_WORDS,
             const WordList & IGNORED_WORDS,
-            const WordList & FLAGGED_WORDS);
+            const WordList & FLAGGED_WORDS,
+            ParseProgress * const PROGRESS_PTR = nullptr);
+
+        FileParser(const FileParser &) = delete;
+        FileParser(FileParser &&) = delete;
+        FileParser & operator=(const FileParser &) = delete;
+        FileParser & operator=(FileParser &&) = delete;
 
-        inline const WordCountVec_t & words() const { return m_wordCounts; }
+        // only Code has words unless ArgsParser::willSplitVocabularies()
+        const WordCountVec_t & words(const Vocabulary::Enum VOCABULARY = Vocabulary::Code) const;
 
         const WordCount & wordCountObj(const std::size_t INDEX) const;
 
@@ -68,22 +170,93 @@ namespace word_stacker
             return wordCountObj(INDEX).count();
         }
 
-        inline const LengthCountMap_t & lengthCountMap() const { return m_lengthCountMap; }
+        inline const LineMetrics & lineMetrics() const { return m_lineMetrics; }
+
+        inline const LineMetricsSummary & lineMetricsSummary() const
+        {
+            return m_lineMetricsSummary;
+        }
+
+        // keyed by extension including the dot, or an empty string for files without one
+        inline const std::map<std::string, LineMetrics> & extensionLineMetrics() const
+        {
+            return m_extensionLineMetrics;
+        }
+
+        // sorted by the 99th percentile line length, longest first
+        inline const std::vector<FileLineSummary> & fileLineSummaries() const
+        {
+            return m_fileLineSummaries;
+        }
 
       private:
-        void parseDirectoryOrFile(ParseSupplies & supplies, const std::string & PATH_STR);
-        void openFileAndParse(ParseSupplies & supplies, const std::string & FILE_PATH);
-        void parseFileContentsText(ParseSupplies & supplies, std::ifstream & file);
-        void parseFileContentsCode(ParseSupplies & supplies, std::ifstream & file);
-        void parseWord(ParseSupplies & supplies, const std::string & WORD);
-        void logStatistics(ReportMaker &, const FreqStats &);
-        bool doesFilenameMatchParseType(ParseSupplies & supplies, const std::string &) const;
+        void runPipeline(ParseSupplies & supplies);
 
-        void changeInvalidCharactersToSpaces(
-            std::string & s, const std::string & CHARS_TO_KEEP) const;
+        static TokenizeKernel
+            selectKernel(const ParseSupplies & SUPPLIES, const bool IS_SHARED_COUNT);
+
+        // the identifier and vocabulary flags are ignored for Text
+        static TokenizeKernel selectKernel(
+            const ParseType::Enum PARSE_TYPE,
+            const bool WILL_SKIP_COMMON,
+            const bool HAS_IGNORED,
+            const bool HAS_FLAGGED,
+            const bool IS_SHARED_COUNT,
+            const bool WILL_SPLIT_IDENTIFIERS,
+            const bool WILL_KEEP_IDENTIFIERS,
+            const bool WILL_SPLIT_VOCABULARIES);
+
+        template <typename Policy_t>
+        static TokenizeKernel makeKernel();
+
+        // PATH is only used to break down the line lengths, it can be empty, and HEAD_TEXT is
+        // tokenized before the rest of file, since the start of it was already read and cut
+        template <typename Policy_t>
+        void parseFileContents(
+            ParseSupplies & supplies,
+            const std::string & PATH,
+            const std::string & HEAD_TEXT,
+            std::istream & file) const;
+
+        template <typename Policy_t>
+        void parseFileContents(
+            ParseSupplies & supplies,
+            const std::string & PATH,
+            const char * const BEGIN,
+            const std::size_t SIZE) const;
+
+        // tokenizes TEXT as PARSE_TYPE but keeps only its lines, they are added to the lines of the
+        // file counts is tokenizing, so boilerplate cut out is still in the line counts and metrics
+        static void countLines(
+            const ParseType::Enum PARSE_TYPE, ParseCounts & counts, const std::string & TEXT);
+
+        template <typename Policy_t>
+        void parseWord(
+            ParseSupplies & supplies,
+            const std::string & WORD,
+            const Vocabulary::Enum VOCABULARY) const;
+
+        // times every kernel for this parse type, and these identifier and vocabulary settings, on
+        // a sample of PATHS read into memory first, split over THREAD_COUNT threads like the
+        // parse, so the shared table shows contention
+        void benchmarkKernels(
+            const ParseSupplies & SUPPLIES, const StrVec_t & PATHS, const std::size_t THREAD_COUNT);
+
+        // true if there is a zero byte, or if more than a tenth of the bytes are not valid UTF-8
+        static bool doesContentLookBinary(const char * const BEGIN, const std::size_t SIZE);
+
+        // moves one vocabulary out of counts into wordCounts, sorted, and notes its statistics
+        void makeVocabulary(
+            ParseCounts & counts, const Vocabulary::Enum VOCABULARY, WordCountVec_t & wordCounts);
+
+        void logStatistics(ReportMaker &, const FreqStats &);
+        void logLineMetrics(ReportMaker &) const;
+        bool doesFilenameMatchParseType(const ParseSupplies & SUPPLIES, const std::string &) const;
 
       private:
         WordCountVec_t m_wordCounts;
+        WordCountVec_t m_commentWordCounts;
+        WordCountVec_t m_stringWordCounts;
         std::size_t m_lineCount;
         std::size_t m_unCLineCount;
         std::size_t m_singleCount;
@@ -91,7 +264,45 @@ namespace word_stacker
         std::size_t m_fileCount;
         std::size_t m_dirCount;
         std::size_t m_flaggedCount;
-        LengthCountMap_t m_lengthCountMap;
+        std::size_t m_walkedFileCount;
+        std::size_t m_walkLoopCount;
+        std::size_t m_walkSyscallCount;
+        std::size_t m_walkSyscallEstimate;
+        std::size_t m_overlongCount;
+        std::size_t m_splitIdentifierCount;
+        std::size_t m_ignoredDirCount;
+        std::size_t m_ignoredFileCount;
+        std::size_t m_ignoredByteCount;
+        std::size_t m_binaryFileCount;
+        std::size_t m_binaryByteCount;
+        std::size_t m_duplicateContentCount;
+        std::size_t m_duplicateCount;
+        std::size_t m_duplicateByteCount;
+        std::size_t m_duplicateReuseCount;
+        std::size_t m_duplicateHashCount;
+        std::size_t m_duplicateRereadCount;
+        std::size_t m_duplicateUnreadCount;
+        std::string m_boilerplateAction;
+        std::size_t m_boilerplateWindowCount;
+        std::size_t m_boilerplateFileCount;
+        std::size_t m_boilerplateLineCount;
+        std::size_t m_boilerplateDistinctLineCount;
+        LineMetrics m_lineMetrics;
+        LineMetricsSummary m_lineMetricsSummary;
+        std::map<std::string, LineMetrics> m_extensionLineMetrics;
+        std::vector<FileLineSummary> m_fileLineSummaries;
+        StageTimes m_discoveryTimes;
+        StageTimes m_readingTimes;
+        StageTimes m_tokenizingTimes;
+        StageTimes::Duration_t m_aggregationTime;
+        std::size_t m_countTableShardCount;
+        std::size_t m_countTableEntryCount;
+        std::string m_kernelName;
+        StrVec_t m_kernelBenchmarks;
+        StrVec_t m_vocabularyStats;
+
+        // only used while the constructor runs
+        ParseProgress * m_progressPtr;
     };
 } // namespace word_stacker
 
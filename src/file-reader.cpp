@@ -0,0 +1,468 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// file-reader.cpp
+//
+#include "assert-or-throw.hpp"
+#include "file-reader.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <exception>
+#include <fstream>
+
+#if defined(WORDSTACKER_HAS_IO_URING)
+#include <fcntl.h>
+#include <liburing.h>
+#include <unistd.h>
+#endif
+
+namespace word_stacker
+{
+
+#if defined(WORDSTACKER_HAS_IO_URING)
+    struct FileReader::Ring
+    {
+        io_uring ring;
+    };
+#else
+    struct FileReader::Ring
+    {};
+#endif
+
+    FileReader::FileReader(const std::size_t IN_FLIGHT_MAX, const std::size_t BUFFER_SIZE)
+        : M_IN_FLIGHT_MAX(std::max(std::size_t(1), IN_FLIGHT_MAX))
+        , M_BUFFER_SIZE(std::max(std::size_t(1), BUFFER_SIZE))
+        , m_ringUPtr()
+        , m_batchedCount(0)
+        , m_blockingCount(0)
+        , m_tooBigCount(0)
+        , m_buffer()
+    {
+#if defined(WORDSTACKER_HAS_IO_URING)
+        auto ringUPtr{ std::make_unique<Ring>() };
+
+        if (io_uring_queue_init(static_cast<unsigned>(M_IN_FLIGHT_MAX), &ringUPtr->ring, 0) < 0)
+        {
+            return;
+        }
+
+        // openat/read/close through io_uring all need kernel 5.6+, so check before relying on them
+        auto probePtr{ io_uring_get_probe_ring(&ringUPtr->ring) };
+
+        auto const ARE_ALL_OPS_SUPPORTED{ (
+            (probePtr != nullptr) && io_uring_opcode_supported(probePtr, IORING_OP_OPENAT) &&
+            io_uring_opcode_supported(probePtr, IORING_OP_READ) &&
+            io_uring_opcode_supported(probePtr, IORING_OP_CLOSE)) };
+
+        if (probePtr != nullptr)
+        {
+            io_uring_free_probe(probePtr);
+        }
+
+        if (ARE_ALL_OPS_SUPPORTED == false)
+        {
+            io_uring_queue_exit(&ringUPtr->ring);
+            return;
+        }
+
+        m_ringUPtr = std::move(ringUPtr);
+#endif
+    }
+
+    FileReader::~FileReader()
+    {
+#if defined(WORDSTACKER_HAS_IO_URING)
+        if (m_ringUPtr)
+        {
+            io_uring_queue_exit(&m_ringUPtr->ring);
+        }
+#endif
+    }
+
+    void FileReader::read(
+        const PathSource_t & NEXT_PATH,
+        const Callback_t & CALLBACK,
+        const TooBigCallback_t & TOO_BIG_CALLBACK)
+    {
+#if defined(WORDSTACKER_HAS_IO_URING)
+        if (isUsingIoUring())
+        {
+            readBatched(NEXT_PATH, CALLBACK, TOO_BIG_CALLBACK);
+        }
+#endif
+
+        // everything when io_uring is not used, and whatever is left if it failed part way
+        std::string path;
+        while (NEXT_PATH(path))
+        {
+            readBlocking(path, CALLBACK, TOO_BIG_CALLBACK);
+        }
+    }
+
+#if defined(WORDSTACKER_HAS_IO_URING)
+    void FileReader::readBatched(
+        const PathSource_t & NEXT_PATH,
+        const Callback_t & CALLBACK,
+        const TooBigCallback_t & TOO_BIG_CALLBACK)
+    {
+        // each slot owns one file at a time and has at most one operation in flight
+        struct Slot
+        {
+            enum Stage
+            {
+                Open,
+                Read,
+                Close
+            };
+
+            std::string path{};
+            int fd = -1;
+            Stage stage = Open;
+            bool isTooBig = false;
+            bool hasFailed = false;
+            std::vector<char> buffer{};
+
+            // from when path is taken until its close completes
+            bool isBusy = false;
+
+            // true once the read of path completed, whether or not it failed
+            bool wasRead = false;
+        };
+
+        auto & ring{ m_ringUPtr->ring };
+
+        // the kernel writes into these buffers until each read completes, so nothing may throw
+        // while any operation is in flight, and the first error is only thrown once they are all
+        // done and every file opened is closed again
+        auto slotsUPtr{ std::make_unique<std::vector<Slot>>(M_IN_FLIGHT_MAX) };
+        auto & slots{ *slotsUPtr };
+        std::size_t inFlightCount{ 0 };
+        std::string errorMessage;
+        std::exception_ptr callbackExceptionPtr;
+
+        auto const IS_FAILING{ [&]() {
+            return ((errorMessage.empty() == false) || callbackExceptionPtr);
+        } };
+
+        auto fail{ [&](Slot & slot, const std::string & MESSAGE) {
+            slot.hasFailed = true;
+
+            if (IS_FAILING() == false)
+            {
+                errorMessage = MESSAGE;
+            }
+        } };
+
+        auto callSafely{ [&](const auto & FUNCTION, Slot & slot, const std::size_t SIZE) {
+            try
+            {
+                FUNCTION(slot.path, slot.buffer.data(), SIZE);
+                return true;
+            }
+            catch (...)
+            {
+                slot.hasFailed = true;
+
+                if (IS_FAILING() == false)
+                {
+                    callbackExceptionPtr = std::current_exception();
+                }
+
+                return false;
+            }
+        } };
+
+        auto submit{ [&](Slot & slot, const Slot::Stage STAGE) {
+            auto sqePtr{ io_uring_get_sqe(&ring) };
+
+            M_LOG_AND_ASSERT_OR_THROW(
+                (sqePtr != nullptr),
+                "word_stacker::FileReader::readBatched() io_uring submission queue was full.");
+
+            slot.stage = STAGE;
+
+            switch (STAGE)
+            {
+                case Slot::Open:
+                {
+                    io_uring_prep_openat(
+                        sqePtr, AT_FDCWD, slot.path.c_str(), O_RDONLY | O_CLOEXEC, 0);
+
+                    break;
+                }
+                case Slot::Read:
+                {
+                    io_uring_prep_read(
+                        sqePtr,
+                        slot.fd,
+                        slot.buffer.data(),
+                        static_cast<unsigned>(slot.buffer.size()),
+                        0);
+
+                    break;
+                }
+                case Slot::Close:
+                default:
+                {
+                    io_uring_prep_close(sqePtr, slot.fd);
+                    break;
+                }
+            }
+
+            io_uring_sqe_set_data(sqePtr, &slot);
+            ++inFlightCount;
+        } };
+
+        // once anything failed no more files are started, so the ring drains
+        auto startNextFile{ [&](Slot & slot) {
+            slot.isBusy = ((IS_FAILING() == false) && NEXT_PATH(slot.path));
+
+            if (slot.isBusy)
+            {
+                slot.fd = -1;
+                slot.isTooBig = false;
+                slot.hasFailed = false;
+                slot.wasRead = false;
+                submit(slot, Slot::Open);
+            }
+        } };
+
+        for (auto & slot : slots)
+        {
+            slot.buffer.resize(M_BUFFER_SIZE);
+            startNextFile(slot);
+        }
+
+        int submitResult{ 0 };
+
+        while (inFlightCount > 0)
+        {
+            submitResult = io_uring_submit_and_wait(&ring, 1);
+
+            if (-EINTR == submitResult)
+            {
+                continue;
+            }
+
+            if (submitResult < 0)
+            {
+                break;
+            }
+
+            unsigned head{ 0 };
+            unsigned seenCount{ 0 };
+            io_uring_cqe * cqePtr{ nullptr };
+            io_uring_for_each_cqe(&ring, head, cqePtr)
+            {
+                ++seenCount;
+                --inFlightCount;
+
+                auto & slot{ *static_cast<Slot *>(io_uring_cqe_get_data(cqePtr)) };
+                auto const RESULT{ cqePtr->res };
+                auto const & PATH{ slot.path };
+
+                switch (slot.stage)
+                {
+                    case Slot::Open:
+                    {
+                        if (RESULT < 0)
+                        {
+                            // nothing was opened, so there is nothing to close
+                            fail(
+                                slot,
+                                ("word_stacker::FileReader::readBatched(file_path=\"" + PATH +
+                                 "\") failed to open that file:  " + std::strerror(-RESULT)));
+
+                            slot.isBusy = false;
+                            startNextFile(slot);
+                            break;
+                        }
+
+                        slot.fd = RESULT;
+
+                        if (IS_FAILING())
+                        {
+                            submit(slot, Slot::Close);
+                        }
+                        else
+                        {
+                            submit(slot, Slot::Read);
+                        }
+
+                        break;
+                    }
+                    case Slot::Read:
+                    {
+                        slot.wasRead = true;
+
+                        if (RESULT < 0)
+                        {
+                            fail(
+                                slot,
+                                ("word_stacker::FileReader::readBatched(file_path=\"" + PATH +
+                                 "\") failed to read that file:  " + std::strerror(-RESULT)));
+
+                            submit(slot, Slot::Close);
+                            break;
+                        }
+
+                        auto const SIZE{ static_cast<std::size_t>(RESULT) };
+
+                        // a full buffer means there might be more
+                        slot.isTooBig = (SIZE >= slot.buffer.size());
+
+                        if ((slot.isTooBig == false) && (IS_FAILING() == false) &&
+                            callSafely(CALLBACK, slot, SIZE))
+                        {
+                            ++m_batchedCount;
+                        }
+
+                        submit(slot, Slot::Close);
+                        break;
+                    }
+                    case Slot::Close:
+                    default:
+                    {
+                        slot.fd = -1;
+
+                        if (slot.isTooBig && (slot.hasFailed == false) &&
+                            (IS_FAILING() == false) &&
+                            callSafely(TOO_BIG_CALLBACK, slot, slot.buffer.size()))
+                        {
+                            ++m_tooBigCount;
+                        }
+
+                        slot.isBusy = false;
+                        startNextFile(slot);
+                        break;
+                    }
+                }
+            }
+
+            io_uring_cq_advance(&ring, seenCount);
+        }
+
+        // when submitting fails the ring is drained and closed, and the files it had not finished
+        // are read without it below, while read() reads the rest
+        if (submitResult < 0)
+        {
+            // the entries still queued never reached the kernel, so only the others complete
+            auto kernelCount{ inFlightCount - io_uring_sq_ready(&ring) };
+
+            while (kernelCount > 0)
+            {
+                io_uring_cqe * cqePtr{ nullptr };
+                auto const WAIT_RESULT{ io_uring_wait_cqe(&ring, &cqePtr) };
+
+                if (-EINTR == WAIT_RESULT)
+                {
+                    continue;
+                }
+
+                if (WAIT_RESULT < 0)
+                {
+                    // reads may still be in flight with no way to wait for them, so the buffers
+                    // are left to the kernel instead of freed under it
+                    slotsUPtr.release();
+
+                    M_LOG_AND_ASSERT_OR_THROW(
+                        false,
+                        "word_stacker::FileReader::readBatched() io_uring_submit_and_wait() "
+                        "failed:  "
+                            << std::strerror(-submitResult)
+                            << ", and then io_uring_wait_cqe() failed:  "
+                            << std::strerror(-WAIT_RESULT));
+                }
+
+                auto & slot{ *static_cast<Slot *>(io_uring_cqe_get_data(cqePtr)) };
+                auto const RESULT{ cqePtr->res };
+                io_uring_cqe_seen(&ring, cqePtr);
+                --kernelCount;
+
+                // anything read now is read again below, so only the descriptors are kept
+                if ((Slot::Open == slot.stage) && (RESULT >= 0))
+                {
+                    slot.fd = RESULT;
+                }
+                else if (Slot::Close == slot.stage)
+                {
+                    slot.fd = -1;
+                }
+            }
+
+            io_uring_queue_exit(&ring);
+            m_ringUPtr.reset();
+
+            for (auto & slot : slots)
+            {
+                // a read or close that never reached the kernel left its file open
+                if (slot.fd >= 0)
+                {
+                    ::close(slot.fd);
+                    slot.fd = -1;
+                }
+            }
+        }
+
+        // the ring is idle and every file is closed, so now it is safe to unwind
+        if (callbackExceptionPtr)
+        {
+            std::rethrow_exception(callbackExceptionPtr);
+        }
+
+        M_LOG_AND_ASSERT_OR_THROW(errorMessage.empty(), errorMessage);
+
+        // only when submitting failed are any files left unfinished
+        for (auto & slot : slots)
+        {
+            if (slot.isBusy == false)
+            {
+                continue;
+            }
+
+            if (slot.wasRead == false)
+            {
+                readBlocking(slot.path, CALLBACK, TOO_BIG_CALLBACK);
+            }
+            else if (slot.isTooBig && (slot.hasFailed == false))
+            {
+                TOO_BIG_CALLBACK(slot.path, slot.buffer.data(), slot.buffer.size());
+                ++m_tooBigCount;
+            }
+        }
+    }
+#endif
+
+    void FileReader::readBlocking(
+        const std::string & PATH,
+        const Callback_t & CALLBACK,
+        const TooBigCallback_t & TOO_BIG_CALLBACK)
+    {
+        std::ifstream file;
+        file.open(PATH, std::ios::binary);
+
+        M_LOG_AND_ASSERT_OR_THROW(
+            (file.is_open()),
+            "word_stacker::FileReader::readBlocking(file_path=\""
+                << PATH << "\") failed to open that file.");
+
+        m_buffer.resize(M_BUFFER_SIZE);
+        file.read(m_buffer.data(), static_cast<std::streamsize>(m_buffer.size()));
+        auto const SIZE{ static_cast<std::size_t>(file.gcount()) };
+        file.close();
+
+        if (SIZE >= m_buffer.size())
+        {
+            TOO_BIG_CALLBACK(PATH, m_buffer.data(), SIZE);
+            ++m_tooBigCount;
+        }
+        else
+        {
+            CALLBACK(PATH, m_buffer.data(), SIZE);
+            ++m_blockingCount;
+        }
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,84 @@
+#ifndef WORDSTACKER_FILEREADER_HPP_INCLUDED
+#define WORDSTACKER_FILEREADER_HPP_INCLUDED
+//
+// file-reader.hpp
+//
+#include <cstddef> //for std::size_t
+#include <functional>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    using StrVec_t = std::vector<std::string>;
+
+    // Responsible for reading many files and handing each one's contents to a callback.
+    // When io_uring is available the opens, reads, and closes are submitted in batches with a
+    // bounded number of files in flight, otherwise each file is read with a blocking std::ifstream.
+    // If io_uring stops taking submissions part way, the files it had not finished and all the
+    // rest are read the blocking way instead.
+    // Files too big for one read buffer are not read any further, their paths go to
+    // TOO_BIG_CALLBACK along with the first buffer full, enough to tell what kind of file it is.
+    class FileReader
+    {
+      public:
+        // returns false when there are no more paths to read
+        using PathSource_t = std::function<bool(std::string & path)>;
+
+        using Callback_t = std::function<void(
+            const std::string & PATH, const char * const BEGIN, const std::size_t SIZE)>;
+
+        // BEGIN and SIZE are only the start of the file
+        using TooBigCallback_t = std::function<void(
+            const std::string & PATH, const char * const BEGIN, const std::size_t SIZE)>;
+
+        explicit FileReader(
+            const std::size_t IN_FLIGHT_MAX = 64, const std::size_t BUFFER_SIZE = (256 * 1024));
+
+        ~FileReader();
+
+        FileReader(const FileReader &) = delete;
+        FileReader(FileReader &&) = delete;
+        FileReader & operator=(const FileReader &) = delete;
+        FileReader & operator=(FileReader &&) = delete;
+
+        void read(
+            const PathSource_t & NEXT_PATH,
+            const Callback_t & CALLBACK,
+            const TooBigCallback_t & TOO_BIG_CALLBACK);
+
+        inline bool isUsingIoUring() const { return (m_ringUPtr.get() != nullptr); }
+        inline std::size_t batchedCount() const { return m_batchedCount; }
+        inline std::size_t blockingCount() const { return m_blockingCount; }
+        inline std::size_t tooBigCount() const { return m_tooBigCount; }
+
+      private:
+#if defined(WORDSTACKER_HAS_IO_URING)
+        void readBatched(
+            const PathSource_t & NEXT_PATH,
+            const Callback_t & CALLBACK,
+            const TooBigCallback_t & TOO_BIG_CALLBACK);
+#endif
+
+        void readBlocking(
+            const std::string & PATH,
+            const Callback_t & CALLBACK,
+            const TooBigCallback_t & TOO_BIG_CALLBACK);
+
+      private:
+        struct Ring;
+
+        const std::size_t M_IN_FLIGHT_MAX;
+        const std::size_t M_BUFFER_SIZE;
+        std::unique_ptr<Ring> m_ringUPtr;
+        std::size_t m_batchedCount;
+        std::size_t m_blockingCount;
+        std::size_t m_tooBigCount;
+        std::vector<char> m_buffer;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_FILEREADER_HPP_INCLUDED
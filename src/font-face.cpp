@@ -0,0 +1,194 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// font-face.cpp
+//
+#include "font-face.hpp"
+
+#if defined(WORDSTACKER_HAS_FREETYPE)
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#endif
+
+namespace word_stacker
+{
+
+#if defined(WORDSTACKER_HAS_FREETYPE)
+    struct FontFace::Face
+    {
+        // see sf::Font::setCurrentSize()
+        bool setSize(const unsigned CHARACTER_SIZE)
+        {
+            return (
+                (face->size->metrics.x_ppem == CHARACTER_SIZE) ||
+                (FT_Set_Pixel_Sizes(face, 0, CHARACTER_SIZE) == 0));
+        }
+
+        FT_Library library = nullptr;
+        FT_Face face = nullptr;
+    };
+#else
+    struct FontFace::Face
+    {};
+#endif
+
+    FontFace::FontFace(const sf::Font & FONT)
+        : m_fontPtr(&FONT)
+        , m_loadedFontUPtr()
+        , m_faceUPtr()
+    {}
+
+    FontFace::FontFace()
+        : m_fontPtr(nullptr)
+        , m_loadedFontUPtr()
+        , m_faceUPtr()
+    {}
+
+    FontFace::~FontFace()
+    {
+#if defined(WORDSTACKER_HAS_FREETYPE)
+        if (m_faceUPtr)
+        {
+            FT_Done_Face(m_faceUPtr->face);
+            FT_Done_FreeType(m_faceUPtr->library);
+        }
+#endif
+    }
+
+    bool FontFace::loadFromFile(const std::string & PATH)
+    {
+#if defined(WORDSTACKER_HAS_FREETYPE)
+        auto faceUPtr{ std::make_unique<Face>() };
+
+        if (FT_Init_FreeType(&faceUPtr->library) != 0)
+        {
+            return false;
+        }
+
+        // sfml only reads unicode charmaps, so the same glyphs are found here
+        if ((FT_New_Face(faceUPtr->library, PATH.c_str(), 0, &faceUPtr->face) != 0) ||
+            (FT_Select_Charmap(faceUPtr->face, FT_ENCODING_UNICODE) != 0))
+        {
+            if (faceUPtr->face != nullptr)
+            {
+                FT_Done_Face(faceUPtr->face);
+            }
+
+            FT_Done_FreeType(faceUPtr->library);
+            return false;
+        }
+
+        m_faceUPtr = std::move(faceUPtr);
+        return true;
+#else
+        m_loadedFontUPtr = std::make_unique<sf::Font>();
+
+        if (m_loadedFontUPtr->loadFromFile(PATH) == false)
+        {
+            return false;
+        }
+
+        m_fontPtr = m_loadedFontUPtr.get();
+        return true;
+#endif
+    }
+
+#if defined(WORDSTACKER_HAS_FREETYPE)
+    const sf::Glyph FontFace::glyph(const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const
+    {
+        if (isRasterizing())
+        {
+            return m_fontPtr->getGlyph(CHAR, CHARACTER_SIZE, false);
+        }
+
+        auto const FACE{ m_faceUPtr->face };
+        sf::Glyph glyph;
+
+        // the same size and flags as sf::Font::loadGlyph(), but FT_Glyph_To_Bitmap() is skipped
+        if ((m_faceUPtr->setSize(CHARACTER_SIZE) == false) ||
+            (FT_Load_Char(FACE, CHAR, (FT_LOAD_TARGET_NORMAL | FT_LOAD_FORCE_AUTOHINT)) != 0))
+        {
+            return glyph;
+        }
+
+        auto const & METRICS{ FACE->glyph->metrics };
+        const float TO_PIXELS{ 1.0f / 64.0f };
+
+        glyph.advance = (static_cast<float>(METRICS.horiAdvance) * TO_PIXELS);
+
+        // sfml only sets the bounds of glyphs with pixels, and hinted metrics are whole pixels
+        if ((METRICS.width > 0) && (METRICS.height > 0))
+        {
+            glyph.bounds.left = (static_cast<float>(METRICS.horiBearingX) * TO_PIXELS);
+            glyph.bounds.top = -(static_cast<float>(METRICS.horiBearingY) * TO_PIXELS);
+            glyph.bounds.width = (static_cast<float>(METRICS.width) * TO_PIXELS);
+            glyph.bounds.height = (static_cast<float>(METRICS.height) * TO_PIXELS);
+        }
+
+        return glyph;
+    }
+
+    float FontFace::kerning(
+        const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const
+    {
+        if (isRasterizing())
+        {
+            return m_fontPtr->getKerning(PREV_CHAR, CHAR, CHARACTER_SIZE);
+        }
+
+        auto const FACE{ m_faceUPtr->face };
+
+        if ((0 == PREV_CHAR) || (0 == CHAR) || !FT_HAS_KERNING(FACE) ||
+            (m_faceUPtr->setSize(CHARACTER_SIZE) == false))
+        {
+            return 0.0f;
+        }
+
+        FT_Vector kerning;
+        FT_Get_Kerning(
+            FACE,
+            FT_Get_Char_Index(FACE, PREV_CHAR),
+            FT_Get_Char_Index(FACE, CHAR),
+            FT_KERNING_DEFAULT,
+            &kerning);
+
+        // bitmap fonts give their kerning in pixels already
+        if (!FT_IS_SCALABLE(FACE))
+        {
+            return static_cast<float>(kerning.x);
+        }
+
+        return (static_cast<float>(kerning.x) / 64.0f);
+    }
+#else
+    const sf::Glyph FontFace::glyph(const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const
+    {
+        return m_fontPtr->getGlyph(CHAR, CHARACTER_SIZE, false);
+    }
+
+    float FontFace::kerning(
+        const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const
+    {
+        return m_fontPtr->getKerning(PREV_CHAR, CHAR, CHARACTER_SIZE);
+    }
+#endif
+
+    std::size_t FontFace::pageByteCount(const std::set<unsigned> & PAGE_SIZES) const
+    {
+        if (!isRasterizing())
+        {
+            return 0;
+        }
+
+        std::size_t byteCount{ 0 };
+
+        for (auto const PAGE_SIZE : PAGE_SIZES)
+        {
+            auto const TEXTURE_SIZE{ m_fontPtr->getTexture(PAGE_SIZE).getSize() };
+            byteCount += (static_cast<std::size_t>(TEXTURE_SIZE.x) * TEXTURE_SIZE.y * 4);
+        }
+
+        return byteCount;
+    }
+
+} // namespace word_stacker
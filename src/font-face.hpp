@@ -0,0 +1,65 @@
+#ifndef WORDSTACKER_FONTFACE_HPP_INCLUDED
+#define WORDSTACKER_FONTFACE_HPP_INCLUDED
+//
+// font-face.hpp
+//
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <memory>
+#include <set>
+#include <string>
+
+namespace word_stacker
+{
+
+    // Responsible for reading the advance, bounds, and kerning of glyphs the same way sf::Font
+    // does.  Made from an sf::Font it reads through that font, which rasterizes every glyph into
+    // a texture page for its character size, and that is what drawing needs.  Loaded from a file
+    // with FreeType available it reads only the hinted metrics of each glyph and never rasterizes
+    // anything, so measuring on another thread costs no second set of texture pages.  Without
+    // FreeType a file is loaded into an sf::Font of its own, and pageByteCount() counts its pages.
+    class FontFace
+    {
+      public:
+        // FONT must outlive this
+        explicit FontFace(const sf::Font & FONT);
+
+        // call loadFromFile() before anything else
+        FontFace();
+
+        ~FontFace();
+
+        FontFace(const FontFace &) = delete;
+        FontFace(FontFace &&) = delete;
+        FontFace & operator=(const FontFace &) = delete;
+        FontFace & operator=(FontFace &&) = delete;
+
+        bool loadFromFile(const std::string & PATH);
+
+        // see sf::Font::getGlyph(), the texture rect is empty unless isRasterizing()
+        const sf::Glyph glyph(const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const;
+
+        // see sf::Font::getKerning()
+        float kerning(
+            const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned CHARACTER_SIZE) const;
+
+        // true if every glyph read costs space in a texture page of its character size
+        inline bool isRasterizing() const { return (m_faceUPtr.get() == nullptr); }
+
+        // the memory of the texture pages of PAGE_SIZES at four bytes a pixel, zero when the
+        // glyphs are not rasterized
+        std::size_t pageByteCount(const std::set<unsigned> & PAGE_SIZES) const;
+
+      private:
+        struct Face;
+
+        // the font given, or the one loaded when FreeType is not available
+        const sf::Font * m_fontPtr;
+        std::unique_ptr<sf::Font> m_loadedFontUPtr;
+        std::unique_ptr<Face> m_faceUPtr;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_FONTFACE_HPP_INCLUDED
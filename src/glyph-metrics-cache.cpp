@@ -0,0 +1,193 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// glyph-metrics-cache.cpp
+//
+#include "glyph-metrics-cache.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace word_stacker
+{
+
+    const unsigned GlyphMetricsCache::REFERENCE_SIZE{ 100 };
+
+    template <typename GlyphAt_t, typename KerningOf_t>
+    const sf::FloatRect GlyphMetricsCache::calcBounds(
+        const sf::String & STRING,
+        const unsigned FONT_SIZE,
+        GlyphAt_t GLYPH_AT,
+        KerningOf_t KERNING_OF)
+    {
+        if (STRING.isEmpty())
+        {
+            return sf::FloatRect();
+        }
+
+        auto const FONT_SIZE_F{ static_cast<float>(FONT_SIZE) };
+
+        // sfml starts the first baseline one character size down, and the bounds this way
+        auto horizPos{ 0.0f };
+        auto const VERT_POS{ FONT_SIZE_F };
+        auto minX{ FONT_SIZE_F };
+        auto minY{ FONT_SIZE_F };
+        auto maxX{ 0.0f };
+        auto maxY{ 0.0f };
+        sf::Uint32 prevChar{ 0 };
+
+        for (std::size_t i(0); i < STRING.getSize(); ++i)
+        {
+            auto const CHAR{ STRING[i] };
+            horizPos += KERNING_OF(prevChar, CHAR);
+            prevChar = CHAR;
+
+            // words and counts never have line breaks, so those are treated as spaces
+            if ((CHAR == ' ') || (CHAR == '\t') || (CHAR == '\n'))
+            {
+                minX = std::min(minX, horizPos);
+                minY = std::min(minY, VERT_POS);
+                horizPos += (GLYPH_AT(' ').advance * ((CHAR == '\t') ? 4.0f : 1.0f));
+                maxX = std::max(maxX, horizPos);
+                maxY = std::max(maxY, VERT_POS);
+                continue;
+            }
+
+            auto const GLYPH{ GLYPH_AT(CHAR) };
+
+            minX = std::min(minX, (horizPos + GLYPH.bounds.left));
+            maxX = std::max(maxX, (horizPos + GLYPH.bounds.left + GLYPH.bounds.width));
+            minY = std::min(minY, (VERT_POS + GLYPH.bounds.top));
+            maxY = std::max(maxY, (VERT_POS + GLYPH.bounds.top + GLYPH.bounds.height));
+
+            horizPos += GLYPH.advance;
+        }
+
+        return sf::FloatRect(minX, minY, (maxX - minX), (maxY - minY));
+    }
+
+    GlyphMetricsCache::GlyphMetricsCache(
+        const FontFace & FONT_FACE, const unsigned SIZES_PER_DOUBLING)
+        : m_fontFace(FONT_FACE)
+        , m_sizesPerDoubling(SIZES_PER_DOUBLING)
+        , m_pageSizes()
+        , m_glyphs()
+        , m_kernings()
+    {}
+
+    const sf::Glyph &
+        GlyphMetricsCache::glyph(const sf::Uint32 CHAR, const unsigned FONT_SIZE) const
+    {
+        auto const KEY{ makeKey(0, CHAR, FONT_SIZE) };
+        auto iter{ m_glyphs.find(KEY) };
+
+        if (iter == std::end(m_glyphs))
+        {
+            auto const PAGE_SIZE{ pageSize(FONT_SIZE) };
+            m_pageSizes.insert(PAGE_SIZE);
+
+            auto glyph{ m_fontFace.glyph(CHAR, PAGE_SIZE) };
+
+            if (PAGE_SIZE != FONT_SIZE)
+            {
+                auto const SCALE{ static_cast<float>(FONT_SIZE) / static_cast<float>(PAGE_SIZE) };
+                glyph.advance *= SCALE;
+                glyph.bounds.left *= SCALE;
+                glyph.bounds.top *= SCALE;
+                glyph.bounds.width *= SCALE;
+                glyph.bounds.height *= SCALE;
+            }
+
+            iter = m_glyphs.emplace(KEY, glyph).first;
+        }
+
+        return iter->second;
+    }
+
+    float GlyphMetricsCache::kerning(
+        const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned FONT_SIZE) const
+    {
+        if (0 == PREV_CHAR)
+        {
+            return 0.0f;
+        }
+
+        auto const KEY{ makeKey(PREV_CHAR, CHAR, FONT_SIZE) };
+        auto iter{ m_kernings.find(KEY) };
+
+        if (iter == std::end(m_kernings))
+        {
+            auto const PAGE_SIZE{ pageSize(FONT_SIZE) };
+
+            auto const KERNING{ m_fontFace.kerning(PREV_CHAR, CHAR, PAGE_SIZE) *
+                                (static_cast<float>(FONT_SIZE) / static_cast<float>(PAGE_SIZE)) };
+
+            iter = m_kernings.emplace(KEY, KERNING).first;
+        }
+
+        return iter->second;
+    }
+
+    const sf::FloatRect
+        GlyphMetricsCache::bounds(const sf::String & STRING, const unsigned FONT_SIZE) const
+    {
+        return calcBounds(
+            STRING,
+            FONT_SIZE,
+            [&](const sf::Uint32 CHAR) { return glyph(CHAR, FONT_SIZE); },
+            [&](const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR) {
+                return kerning(PREV_CHAR, CHAR, FONT_SIZE);
+            });
+    }
+
+    const sf::FloatRect
+        GlyphMetricsCache::predictBounds(const sf::String & STRING, const unsigned FONT_SIZE) const
+    {
+        auto const SCALE{ static_cast<float>(FONT_SIZE) / static_cast<float>(REFERENCE_SIZE) };
+
+        return calcBounds(
+            STRING,
+            FONT_SIZE,
+            [&](const sf::Uint32 CHAR) {
+                auto scaledGlyph{ glyph(CHAR, REFERENCE_SIZE) };
+                scaledGlyph.advance *= SCALE;
+                scaledGlyph.bounds.left *= SCALE;
+                scaledGlyph.bounds.top *= SCALE;
+                scaledGlyph.bounds.width *= SCALE;
+                scaledGlyph.bounds.height *= SCALE;
+                return scaledGlyph;
+            },
+            [&](const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR) {
+                return (kerning(PREV_CHAR, CHAR, REFERENCE_SIZE) * SCALE);
+            });
+    }
+
+    unsigned GlyphMetricsCache::pageSize(const unsigned FONT_SIZE) const
+    {
+        if ((0 == m_sizesPerDoubling) || (FONT_SIZE < 2))
+        {
+            return FONT_SIZE;
+        }
+
+        // the smallest size on the ladder that is not smaller, so glyphs are only ever scaled
+        // down, and the epsilons keep sizes already on the ladder from rounding up a step
+        auto const SIZES_PER_DOUBLING{ static_cast<double>(m_sizesPerDoubling) };
+
+        auto const STEP{ std::ceil(
+            (std::log2(static_cast<double>(FONT_SIZE)) * SIZES_PER_DOUBLING) - 1e-9) };
+
+        auto const PAGE_SIZE{ static_cast<unsigned>(
+            std::ceil(std::exp2(STEP / SIZES_PER_DOUBLING) - 1e-9)) };
+
+        return std::max(FONT_SIZE, PAGE_SIZE);
+    }
+
+    std::uint64_t GlyphMetricsCache::makeKey(
+        const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned FONT_SIZE)
+    {
+        return (
+            (static_cast<std::uint64_t>(FONT_SIZE) << 42) |
+            (static_cast<std::uint64_t>(PREV_CHAR) << 21) | static_cast<std::uint64_t>(CHAR));
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,91 @@
+#ifndef WORDSTACKER_GLYPHMETRICSCACHE_HPP_INCLUDED
+#define WORDSTACKER_GLYPHMETRICSCACHE_HPP_INCLUDED
+//
+// glyph-metrics-cache.hpp
+//
+#include "font-face.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <cstdint>
+#include <set>
+#include <unordered_map>
+
+namespace word_stacker
+{
+
+    // Responsible for measuring strings the way sf::Text does without making one, from the
+    // advances, bounds, and kerning of each glyph, read from the font once for each character
+    // size and kept.  Any size can also be predicted by scaling the glyphs at REFERENCE_SIZE
+    // linearly, which is only off by the pixel or so that hinting rounds each size to.
+    //
+    // The font rasterizes and uploads a whole texture page for every character size, so with
+    // SIZES_PER_DOUBLING more than zero the glyphs of every size are read from the next larger
+    // size on a geometric ladder, and scaled down to the size asked for.  Every metric given
+    // out is already scaled, so measuring and drawing agree no matter which page it came from.
+    // A FontFace that does not rasterize gives the same metrics without any texture pages.
+    class GlyphMetricsCache
+    {
+      public:
+        static const unsigned REFERENCE_SIZE;
+
+        explicit GlyphMetricsCache(
+            const FontFace & FONT_FACE, const unsigned SIZES_PER_DOUBLING = 0);
+
+        GlyphMetricsCache(const GlyphMetricsCache &) = delete;
+        GlyphMetricsCache(GlyphMetricsCache &&) = delete;
+        GlyphMetricsCache & operator=(const GlyphMetricsCache &) = delete;
+        GlyphMetricsCache & operator=(GlyphMetricsCache &&) = delete;
+
+        // the bounds and advance are scaled to FONT_SIZE, but the texture rect is in the
+        // texture page of pageSize(FONT_SIZE), or empty if the FontFace does not rasterize
+        const sf::Glyph & glyph(const sf::Uint32 CHAR, const unsigned FONT_SIZE) const;
+
+        float kerning(
+            const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned FONT_SIZE) const;
+
+        // the local bounds sf::Text would have
+        const sf::FloatRect bounds(const sf::String & STRING, const unsigned FONT_SIZE) const;
+
+        // the local bounds sf::Text would have, scaled from the REFERENCE_SIZE glyphs
+        const sf::FloatRect
+            predictBounds(const sf::String & STRING, const unsigned FONT_SIZE) const;
+
+        inline std::size_t glyphCount() const { return m_glyphs.size(); }
+
+        // the character size of the font texture page that FONT_SIZE is drawn from
+        unsigned pageSize(const unsigned FONT_SIZE) const;
+
+        // the texture pages any glyph was read from so far
+        inline const std::set<unsigned> & pageSizes() const { return m_pageSizes; }
+
+        // the memory of every texture page in pageSizes(), at four bytes a pixel, or zero if
+        // the FontFace does not rasterize
+        inline std::size_t pageByteCount() const { return m_fontFace.pageByteCount(m_pageSizes); }
+
+      private:
+        // characters need 21 bits and no font size comes near 22 bits
+        static std::uint64_t
+            makeKey(const sf::Uint32 PREV_CHAR, const sf::Uint32 CHAR, const unsigned FONT_SIZE);
+
+        // see sf::Text::ensureGeometryUpdate(), GLYPH_AT(CHAR) and KERNING_OF(PREV, CHAR)
+        // return the metrics at FONT_SIZE
+        template <typename GlyphAt_t, typename KerningOf_t>
+        static const sf::FloatRect calcBounds(
+            const sf::String & STRING,
+            const unsigned FONT_SIZE,
+            GlyphAt_t GLYPH_AT,
+            KerningOf_t KERNING_OF);
+
+      private:
+        const FontFace & m_fontFace;
+        unsigned m_sizesPerDoubling;
+        mutable std::set<unsigned> m_pageSizes;
+        mutable std::unordered_map<std::uint64_t, sf::Glyph> m_glyphs;
+        mutable std::unordered_map<std::uint64_t, float> m_kernings;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_GLYPHMETRICSCACHE_HPP_INCLUDED
@@ -0,0 +1,323 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// ignore-rules.cpp
+//
+#include "ignore-rules.hpp"
+
+namespace word_stacker
+{
+
+    IgnoreRules::IgnoreRules()
+        : m_rules()
+    {}
+
+    void IgnoreRules::parse(const std::string & TEXT)
+    {
+        std::size_t lineStart{ 0 };
+
+        while (lineStart < TEXT.size())
+        {
+            auto lineEnd{ TEXT.find('\n', lineStart) };
+            if (lineEnd == std::string::npos)
+            {
+                lineEnd = TEXT.size();
+            }
+
+            std::string line{ TEXT.substr(lineStart, (lineEnd - lineStart)) };
+            lineStart = (lineEnd + 1);
+
+            if (!line.empty() && (line.back() == '\r'))
+            {
+                line.pop_back();
+            }
+
+            // trailing spaces are ignored unless escaped
+            while ((line.size() >= 2) && (line.back() == ' ') && (line[line.size() - 2] != '\\'))
+            {
+                line.pop_back();
+            }
+
+            if ((line == " ") || line.empty() || (line.front() == '#'))
+            {
+                continue;
+            }
+
+            Rule rule;
+
+            if (line.front() == '!')
+            {
+                rule.isNegated = true;
+                line.erase(0, 1);
+            }
+            else if (
+                (line.size() >= 2) && (line[0] == '\\') && ((line[1] == '!') || (line[1] == '#')))
+            {
+                line.erase(0, 1);
+            }
+
+            if (!line.empty() && (line.back() == '/'))
+            {
+                rule.isDirectoryOnly = true;
+                line.pop_back();
+            }
+
+            if (line.empty())
+            {
+                continue;
+            }
+
+            rule.isNameOnly = (line.find('/') == std::string::npos);
+            rule.segments = split(line);
+
+            if (rule.segments.empty())
+            {
+                continue;
+            }
+
+            m_rules.push_back(rule);
+        }
+    }
+
+    IgnoreMatch::Enum
+        IgnoreRules::match(const std::string & RELATIVE_PATH, const bool IS_DIRECTORY) const
+    {
+        auto const PATH_SEGMENTS{ split(RELATIVE_PATH) };
+
+        if (PATH_SEGMENTS.empty())
+        {
+            return IgnoreMatch::None;
+        }
+
+        // the last rule that matches decides
+        for (auto iter{ m_rules.rbegin() }; iter != m_rules.rend(); ++iter)
+        {
+            auto const & RULE{ *iter };
+
+            if (RULE.isDirectoryOnly && !IS_DIRECTORY)
+            {
+                continue;
+            }
+
+            auto const IS_MATCH{ (
+                (RULE.isNameOnly) ? matchSegment(RULE.segments.front(), 0, PATH_SEGMENTS.back(), 0)
+                                  : matchSegments(RULE.segments, 0, PATH_SEGMENTS, 0)) };
+
+            if (IS_MATCH)
+            {
+                return ((RULE.isNegated) ? IgnoreMatch::Include : IgnoreMatch::Ignore);
+            }
+        }
+
+        return IgnoreMatch::None;
+    }
+
+    bool IgnoreRules::matchSegments(
+        const std::vector<std::string> & PATTERN_SEGMENTS,
+        const std::size_t PATTERN_INDEX,
+        const std::vector<std::string> & PATH_SEGMENTS,
+        const std::size_t PATH_INDEX)
+    {
+        if (PATTERN_INDEX == PATTERN_SEGMENTS.size())
+        {
+            return (PATH_INDEX == PATH_SEGMENTS.size());
+        }
+
+        if (PATTERN_SEGMENTS[PATTERN_INDEX] == "**")
+        {
+            // a trailing "/**" matches everything inside, but not the directory itself
+            if ((PATTERN_INDEX + 1) == PATTERN_SEGMENTS.size())
+            {
+                return (PATH_INDEX < PATH_SEGMENTS.size());
+            }
+
+            for (std::size_t i(PATH_INDEX); i <= PATH_SEGMENTS.size(); ++i)
+            {
+                if (matchSegments(PATTERN_SEGMENTS, (PATTERN_INDEX + 1), PATH_SEGMENTS, i))
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        if (PATH_INDEX == PATH_SEGMENTS.size())
+        {
+            return false;
+        }
+
+        return (
+            matchSegment(PATTERN_SEGMENTS[PATTERN_INDEX], 0, PATH_SEGMENTS[PATH_INDEX], 0) &&
+            matchSegments(
+                PATTERN_SEGMENTS, (PATTERN_INDEX + 1), PATH_SEGMENTS, (PATH_INDEX + 1)));
+    }
+
+    bool IgnoreRules::matchSegment(
+        const std::string & PATTERN,
+        const std::size_t PATTERN_POS,
+        const std::string & NAME,
+        const std::size_t NAME_POS)
+    {
+        auto patternPos{ PATTERN_POS };
+        auto namePos{ NAME_POS };
+
+        while (patternPos < PATTERN.size())
+        {
+            auto ch{ PATTERN[patternPos] };
+
+            if ('*' == ch)
+            {
+                while ((patternPos < PATTERN.size()) && (PATTERN[patternPos] == '*'))
+                {
+                    ++patternPos;
+                }
+
+                if (patternPos == PATTERN.size())
+                {
+                    return true;
+                }
+
+                for (std::size_t i(namePos); i <= NAME.size(); ++i)
+                {
+                    if (matchSegment(PATTERN, patternPos, NAME, i))
+                    {
+                        return true;
+                    }
+                }
+
+                return false;
+            }
+
+            if (namePos == NAME.size())
+            {
+                return false;
+            }
+
+            if ('?' == ch)
+            {
+                ++patternPos;
+                ++namePos;
+                continue;
+            }
+
+            if ('[' == ch)
+            {
+                bool isMatch{ false };
+                auto const CLASS_END{ matchClass(PATTERN, patternPos, NAME[namePos], isMatch) };
+
+                // an unclosed '[' is just a character
+                if (CLASS_END > 0)
+                {
+                    if (isMatch == false)
+                    {
+                        return false;
+                    }
+
+                    patternPos = CLASS_END;
+                    ++namePos;
+                    continue;
+                }
+            }
+
+            if (('\\' == ch) && ((patternPos + 1) < PATTERN.size()))
+            {
+                ch = PATTERN[++patternPos];
+            }
+
+            if (ch != NAME[namePos])
+            {
+                return false;
+            }
+
+            ++patternPos;
+            ++namePos;
+        }
+
+        return (namePos == NAME.size());
+    }
+
+    std::size_t IgnoreRules::matchClass(
+        const std::string & PATTERN,
+        const std::size_t PATTERN_POS,
+        const char CH,
+        bool & isMatch)
+    {
+        auto pos{ PATTERN_POS + 1 };
+
+        auto const IS_NEGATED{ (
+            (pos < PATTERN.size()) && ((PATTERN[pos] == '!') || (PATTERN[pos] == '^'))) };
+
+        if (IS_NEGATED)
+        {
+            ++pos;
+        }
+
+        auto const FIRST_POS{ pos };
+        auto isFound{ false };
+
+        while (pos < PATTERN.size())
+        {
+            auto first{ PATTERN[pos] };
+
+            // a ']' right after the '[' is part of the class
+            if ((']' == first) && (pos != FIRST_POS))
+            {
+                isMatch = (isFound != IS_NEGATED);
+                return (pos + 1);
+            }
+
+            if (('\\' == first) && ((pos + 1) < PATTERN.size()))
+            {
+                first = PATTERN[++pos];
+            }
+
+            if (((pos + 2) < PATTERN.size()) && (PATTERN[pos + 1] == '-') &&
+                (PATTERN[pos + 2] != ']'))
+            {
+                if ((CH >= first) && (CH <= PATTERN[pos + 2]))
+                {
+                    isFound = true;
+                }
+
+                pos += 3;
+            }
+            else
+            {
+                if (CH == first)
+                {
+                    isFound = true;
+                }
+
+                ++pos;
+            }
+        }
+
+        return 0;
+    }
+
+    std::vector<std::string> IgnoreRules::split(const std::string & PATH)
+    {
+        std::vector<std::string> segments;
+
+        std::size_t start{ 0 };
+        while (start <= PATH.size())
+        {
+            auto end{ PATH.find('/', start) };
+            if (end == std::string::npos)
+            {
+                end = PATH.size();
+            }
+
+            if (end > start)
+            {
+                segments.push_back(PATH.substr(start, (end - start)));
+            }
+
+            start = (end + 1);
+        }
+
+        return segments;
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,78 @@
+#ifndef WORDSTACKER_IGNORERULES_HPP_INCLUDED
+#define WORDSTACKER_IGNORERULES_HPP_INCLUDED
+//
+// ignore-rules.hpp
+//
+#include <cstddef> //for std::size_t
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    struct IgnoreMatch
+    {
+        enum Enum
+        {
+            None = 0, // no rule matched, so ask the rules of the parent directory
+            Ignore,
+            Include // matched a !negated rule
+        };
+    };
+
+    // Responsible for the rules of the .gitignore and .ignore files in one directory, compiled
+    // once when that directory is entered and then matched against every path below it.  Each
+    // pattern is split on '/' into segments so that "**" can match any number of whole
+    // directories while '*', '?', and [classes] never match across a '/'.
+    class IgnoreRules
+    {
+      public:
+        IgnoreRules();
+
+        // adds every rule in the TEXT of one ignore file, later rules take precedence
+        void parse(const std::string & TEXT);
+
+        inline bool empty() const { return m_rules.empty(); }
+
+        // RELATIVE_PATH is relative to the directory the ignore file was in
+        IgnoreMatch::Enum match(const std::string & RELATIVE_PATH, const bool IS_DIRECTORY) const;
+
+      private:
+        struct Rule
+        {
+            std::vector<std::string> segments{};
+            bool isNegated = false;
+            bool isDirectoryOnly = false;
+
+            // rules without a slash match the name at any depth, not the whole relative path
+            bool isNameOnly = false;
+        };
+
+        static bool matchSegments(
+            const std::vector<std::string> & PATTERN_SEGMENTS,
+            const std::size_t PATTERN_INDEX,
+            const std::vector<std::string> & PATH_SEGMENTS,
+            const std::size_t PATH_INDEX);
+
+        static bool matchSegment(
+            const std::string & PATTERN,
+            const std::size_t PATTERN_POS,
+            const std::string & NAME,
+            const std::size_t NAME_POS);
+
+        // returns the position just after the closing ']', or zero if the class was not closed
+        static std::size_t matchClass(
+            const std::string & PATTERN,
+            const std::size_t PATTERN_POS,
+            const char CH,
+            bool & isMatch);
+
+        static std::vector<std::string> split(const std::string & PATH);
+
+      private:
+        std::vector<Rule> m_rules;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_IGNORERULES_HPP_INCLUDED
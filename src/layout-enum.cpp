@@ -0,0 +1,43 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// layout-enum.cpp
+//
+#include "layout-enum.hpp"
+
+#include <sstream>
+
+namespace word_stacker
+{
+
+    const std::string Layout::toString(const Layout::Enum E)
+    {
+        switch (E)
+        {
+            case Columns:
+            {
+                return "Columns";
+            }
+            case Jumble:
+            {
+                return "Jumble";
+            }
+            case Spiral:
+            {
+                return "Spiral";
+            }
+            case Canvas:
+            {
+                return "Canvas";
+            }
+            case Count:
+            default:
+            {
+                std::ostringstream ss;
+                ss << "(invalid Layout::Enum=" << E << ")";
+                return ss.str();
+            }
+        }
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,28 @@
+#ifndef WORDSTACKER_LAYOUTENUM_HPP_INCLUDED
+#define WORDSTACKER_LAYOUTENUM_HPP_INCLUDED
+//
+// layout-enum.hpp
+//
+#include <string>
+
+namespace word_stacker
+{
+
+    // how the displayed words are arranged on screen
+    struct Layout
+    {
+        enum Enum
+        {
+            Columns = 0,
+            Jumble,
+            Spiral,
+            Canvas,
+            Count
+        };
+
+        static const std::string toString(const Enum);
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_LAYOUTENUM_HPP_INCLUDED
@@ -0,0 +1,149 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// layout-worker.cpp
+//
+#include "layout-worker.hpp"
+
+#include <algorithm>
+
+namespace word_stacker
+{
+
+    LayoutWorker::LayoutWorker()
+        : m_mutex()
+        , m_condition()
+        , m_pendingKeys()
+        , m_makeScene()
+        , m_isMaking(false)
+        , m_makingKey()
+        , m_finishedScenes()
+        , m_errorPtr()
+        , m_willStop(false)
+        , m_thread([this]() { run(); })
+    {}
+
+    LayoutWorker::~LayoutWorker()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_willStop = true;
+        }
+
+        m_condition.notify_all();
+        m_thread.join();
+    }
+
+    void LayoutWorker::request(const std::vector<SceneKey> & KEYS, const MakeScene_t & MAKE_SCENE)
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            m_pendingKeys.assign(std::begin(KEYS), std::end(KEYS));
+
+            if (m_isMaking)
+            {
+                m_pendingKeys.erase(
+                    std::remove(std::begin(m_pendingKeys), std::end(m_pendingKeys), m_makingKey),
+                    std::end(m_pendingKeys));
+            }
+
+            m_makeScene = MAKE_SCENE;
+        }
+
+        m_condition.notify_all();
+    }
+
+    std::vector<std::unique_ptr<Scene>> LayoutWorker::takeScenes()
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+
+        if (m_errorPtr)
+        {
+            auto const ERROR_PTR{ m_errorPtr };
+            m_errorPtr = nullptr;
+            std::rethrow_exception(ERROR_PTR);
+        }
+
+        std::vector<std::unique_ptr<Scene>> scenes;
+        scenes.swap(m_finishedScenes);
+        return scenes;
+    }
+
+    void LayoutWorker::waitForScene()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        m_condition.wait(lock, [&]() {
+            return (
+                !m_finishedScenes.empty() || m_errorPtr ||
+                (!m_isMaking && m_pendingKeys.empty()));
+        });
+    }
+
+    void LayoutWorker::wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [&]() { return (!m_isMaking && m_pendingKeys.empty()); });
+    }
+
+    bool LayoutWorker::isBusy() const
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        return (m_isMaking || !m_pendingKeys.empty());
+    }
+
+    void LayoutWorker::run()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+
+        while (true)
+        {
+            m_condition.wait(lock, [&]() { return (m_willStop || !m_pendingKeys.empty()); });
+
+            if (m_willStop)
+            {
+                return;
+            }
+
+            m_isMaking = true;
+            m_makingKey = m_pendingKeys.front();
+            m_pendingKeys.pop_front();
+
+            auto const KEY{ m_makingKey };
+
+            // copied because a request made meanwhile may replace it
+            auto const MAKE_SCENE{ m_makeScene };
+
+            lock.unlock();
+
+            std::unique_ptr<Scene> sceneUPtr;
+            std::exception_ptr errorPtr;
+
+            try
+            {
+                sceneUPtr = MAKE_SCENE(KEY);
+            }
+            catch (...)
+            {
+                errorPtr = std::current_exception();
+            }
+
+            lock.lock();
+
+            if (sceneUPtr)
+            {
+                m_finishedScenes.push_back(std::move(sceneUPtr));
+            }
+
+            if (errorPtr && !m_errorPtr)
+            {
+                m_errorPtr = errorPtr;
+            }
+
+            m_isMaking = false;
+            m_condition.notify_all();
+        }
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,72 @@
+#ifndef WORDSTACKER_LAYOUTWORKER_HPP_INCLUDED
+#define WORDSTACKER_LAYOUTWORKER_HPP_INCLUDED
+//
+// layout-worker.hpp
+//
+#include "scene.hpp"
+
+#include <condition_variable>
+#include <cstddef> //for std::size_t
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for making scenes on a thread of its own, one at a time and in the order
+    // asked for, so the window keeps drawing meanwhile.  Each request replaces all the scenes
+    // not started yet, so a burst of key presses only leaves the last one's to make.
+    class LayoutWorker
+    {
+      public:
+        using MakeScene_t = std::function<std::unique_ptr<Scene>(const SceneKey &)>;
+
+        LayoutWorker();
+        ~LayoutWorker();
+
+        LayoutWorker(const LayoutWorker &) = delete;
+        LayoutWorker(LayoutWorker &&) = delete;
+        LayoutWorker & operator=(const LayoutWorker &) = delete;
+        LayoutWorker & operator=(LayoutWorker &&) = delete;
+
+        // replaces any keys not started yet with KEYS, leaving out the one being made now
+        void request(const std::vector<SceneKey> & KEYS, const MakeScene_t & MAKE_SCENE);
+
+        // returns the scenes finished since the last call, and re-throws anything
+        // MAKE_SCENE threw
+        std::vector<std::unique_ptr<Scene>> takeScenes();
+
+        // blocks until a scene is finished or there is nothing left to make
+        void waitForScene();
+
+        // blocks until there is nothing left to make
+        void wait();
+
+        bool isBusy() const;
+
+      private:
+        void run();
+
+      private:
+        mutable std::mutex m_mutex;
+        std::condition_variable m_condition;
+        std::deque<SceneKey> m_pendingKeys;
+        MakeScene_t m_makeScene;
+        bool m_isMaking;
+        SceneKey m_makingKey;
+        std::vector<std::unique_ptr<Scene>> m_finishedScenes;
+        std::exception_ptr m_errorPtr;
+        bool m_willStop;
+
+        // the last member, so everything it uses exists before the thread starts
+        std::thread m_thread;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_LAYOUTWORKER_HPP_INCLUDED
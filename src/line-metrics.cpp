@@ -0,0 +1,126 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// line-metrics.cpp
+//
+#include "line-metrics.hpp"
+
+#include <algorithm>
+
+namespace word_stacker
+{
+
+    const std::size_t LineMetrics::DENSE_LENGTH_LIMIT{ 1024 };
+
+    LineMetrics::LineMetrics()
+        : m_denseCounts()
+        , m_sparseCounts()
+        , m_lineCount(0)
+    {}
+
+    void LineMetrics::addSlow(const std::size_t LENGTH)
+    {
+        if (LENGTH >= DENSE_LENGTH_LIMIT)
+        {
+            ++m_sparseCounts[LENGTH];
+            return;
+        }
+
+        auto const SIZE{ std::min(
+            DENSE_LENGTH_LIMIT,
+            std::max({ (LENGTH + 1), (m_denseCounts.size() * 2), std::size_t(128) })) };
+
+        m_denseCounts.resize(SIZE, 0);
+        ++m_denseCounts[LENGTH];
+    }
+
+    void LineMetrics::merge(const LineMetrics & OTHER, const std::size_t WEIGHT)
+    {
+        if (OTHER.m_denseCounts.size() > m_denseCounts.size())
+        {
+            m_denseCounts.resize(OTHER.m_denseCounts.size(), 0);
+        }
+
+        for (std::size_t length(0); length < OTHER.m_denseCounts.size(); ++length)
+        {
+            m_denseCounts[length] += (OTHER.m_denseCounts[length] * WEIGHT);
+        }
+
+        for (auto const & PAIR : OTHER.m_sparseCounts)
+        {
+            m_sparseCounts[PAIR.first] += (PAIR.second * WEIGHT);
+        }
+
+        m_lineCount += (OTHER.m_lineCount * WEIGHT);
+    }
+
+    void LineMetrics::clear()
+    {
+        std::fill(std::begin(m_denseCounts), std::end(m_denseCounts), 0);
+        m_sparseCounts.clear();
+        m_lineCount = 0;
+    }
+
+    LineMetricsSummary LineMetrics::summarize() const
+    {
+        LineMetricsSummary summary;
+        summary.lineCount = m_lineCount;
+
+        if (0 == m_lineCount)
+        {
+            return summary;
+        }
+
+        // the line counts that each percentile is reached at, rounded up
+        auto const P50_TARGET{ ((m_lineCount * 50) + 99) / 100 };
+        auto const P95_TARGET{ ((m_lineCount * 95) + 99) / 100 };
+        auto const P99_TARGET{ ((m_lineCount * 99) + 99) / 100 };
+
+        std::size_t cumulativeCount{ 0 };
+        std::size_t over80Count{ 0 };
+        std::size_t over100Count{ 0 };
+        std::size_t over120Count{ 0 };
+
+        forEach([&](const std::size_t LENGTH, const std::size_t COUNT) {
+            if (0 == summary.distinctLengthCount)
+            {
+                summary.lengthMin = LENGTH;
+                summary.countMin = COUNT;
+            }
+
+            ++summary.distinctLengthCount;
+            summary.lengthMax = LENGTH;
+            summary.countMin = std::min(summary.countMin, COUNT);
+            summary.countMax = std::max(summary.countMax, COUNT);
+
+            if ((cumulativeCount < P50_TARGET) && ((cumulativeCount + COUNT) >= P50_TARGET))
+            {
+                summary.lengthP50 = LENGTH;
+            }
+
+            if ((cumulativeCount < P95_TARGET) && ((cumulativeCount + COUNT) >= P95_TARGET))
+            {
+                summary.lengthP95 = LENGTH;
+            }
+
+            if ((cumulativeCount < P99_TARGET) && ((cumulativeCount + COUNT) >= P99_TARGET))
+            {
+                summary.lengthP99 = LENGTH;
+            }
+
+            cumulativeCount += COUNT;
+
+            over80Count += ((LENGTH > 80) ? COUNT : 0);
+            over100Count += ((LENGTH > 100) ? COUNT : 0);
+            over120Count += ((LENGTH > 120) ? COUNT : 0);
+        });
+
+        auto const LINE_COUNT_F{ static_cast<float>(m_lineCount) };
+        summary.over80Ratio = (static_cast<float>(over80Count) / LINE_COUNT_F);
+        summary.over100Ratio = (static_cast<float>(over100Count) / LINE_COUNT_F);
+        summary.over120Ratio = (static_cast<float>(over120Count) / LINE_COUNT_F);
+
+        return summary;
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,113 @@
+#ifndef WORDSTACKER_LINEMETRICS_HPP_INCLUDED
+#define WORDSTACKER_LINEMETRICS_HPP_INCLUDED
+//
+// line-metrics.hpp
+//
+#include <cstddef> //for std::size_t
+#include <map>
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for wrapping everything worth knowing about a LineMetrics histogram, worked
+    // out once so that nothing has to walk the histogram again, like the graph every frame.
+    struct LineMetricsSummary
+    {
+        std::size_t lineCount = 0;
+
+        // how many different line lengths were seen
+        std::size_t distinctLengthCount = 0;
+
+        std::size_t lengthMin = 0;
+        std::size_t lengthMax = 0;
+
+        // the fewest and most lines that any one line length had
+        std::size_t countMin = 0;
+        std::size_t countMax = 0;
+
+        // the shortest length that at least that percent of lines are no longer than
+        std::size_t lengthP50 = 0;
+        std::size_t lengthP95 = 0;
+        std::size_t lengthP99 = 0;
+
+        // the ratio of lines longer than 80, 100, and 120 characters
+        float over80Ratio = 0.0f;
+        float over100Ratio = 0.0f;
+        float over120Ratio = 0.0f;
+    };
+
+    // Responsible for wrapping the line lengths of one file.
+    struct FileLineSummary
+    {
+        std::string path{};
+        LineMetricsSummary summary{};
+    };
+
+    // Responsible for counting how many lines had each length.  Almost every line is shorter
+    // than DENSE_LENGTH_LIMIT, so those are counted in a vector indexed by length, which only
+    // grows as long as the longest line seen so far.  Longer lines overflow into a sparse map.
+    // Histograms merge by adding, so each thread and each file can count into its own.
+    class LineMetrics
+    {
+      public:
+        static const std::size_t DENSE_LENGTH_LIMIT;
+
+        LineMetrics();
+
+        inline void add(const std::size_t LENGTH)
+        {
+            if (LENGTH < m_denseCounts.size())
+            {
+                ++m_denseCounts[LENGTH];
+            }
+            else
+            {
+                addSlow(LENGTH);
+            }
+
+            ++m_lineCount;
+        }
+
+        // adds everything in OTHER, as if it was counted WEIGHT times
+        void merge(const LineMetrics & OTHER, const std::size_t WEIGHT = 1);
+
+        // empties the histogram but keeps the memory
+        void clear();
+
+        inline bool empty() const { return (0 == m_lineCount); }
+        inline std::size_t lineCount() const { return m_lineCount; }
+
+        // calls CALLBACK(LENGTH, COUNT) for every length with lines, shortest first
+        template <typename Callback_t>
+        void forEach(Callback_t CALLBACK) const
+        {
+            for (std::size_t length(0); length < m_denseCounts.size(); ++length)
+            {
+                if (m_denseCounts[length] > 0)
+                {
+                    CALLBACK(length, m_denseCounts[length]);
+                }
+            }
+
+            for (auto const & PAIR : m_sparseCounts)
+            {
+                CALLBACK(PAIR.first, PAIR.second);
+            }
+        }
+
+        LineMetricsSummary summarize() const;
+
+      private:
+        void addSlow(const std::size_t LENGTH);
+
+      private:
+        std::vector<std::size_t> m_denseCounts;
+        std::map<std::size_t, std::size_t> m_sparseCounts;
+        std::size_t m_lineCount;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_LINEMETRICS_HPP_INCLUDED
@@ -4,20 +4,41 @@
 #include "assert-or-throw.hpp"
 #include "file-parser.hpp"
 #include "parse-displayer.hpp"
+#include "parse-progress.hpp"
 #include "report-maker.hpp"
 #include "word-list.hpp"
 
 #include <SFML/Graphics.hpp>
 #include <SFML/Window.hpp>
 
+#include <algorithm>
+#include <chrono>
 #include <filesystem>
 
 #include <cstddef> //for std::size_t
 #include <cstdlib>
+#include <ctime>
+#include <exception>
+#include <memory>
+#include <thread>
 
 using namespace word_stacker;
 
-void saveScreenshot(sf::RenderWindow &);
+void saveScreenshot(const sf::RenderTexture &);
+
+// parses on a thread of its own while the window shows how far it has gotten, and lays out the
+// most frequent words counted so far now and then, so the shape of the result shows early,
+// and returns null if the window was closed before the parse was done
+std::unique_ptr<FileParser> parseWhileShowingPreviews(
+    sf::RenderWindow & renderWin,
+    ReportMaker & reportMaker,
+    const ArgsParser & ARGS,
+    const WordList & COMMON_WORDS,
+    const WordList & IGNORED_WORDS,
+    const WordList & FLAGGED_WORDS,
+    ParseDisplayer & displayer,
+    const bool WILL_SHOW_COUNTS,
+    const Layout::Enum LAYOUT);
 
 int main(int argc, char * argv[])
 {
@@ -55,13 +76,41 @@ int main(int argc, char * argv[])
                                  << args.flaggedWordsPaths().size() << " files";
     }
 
-    FileParser parser(reportMaker, args, commonWords, ignoredWords, flaggedWords);
+    // made before the displayer so it outlives the layouts still being made when the window closes
+    std::unique_ptr<FileParser> parserUPtr;
 
     ParseDisplayer displayer(args);
 
     auto willDisplayCounts{ true };
-    auto willDisplayAsColumns{ true };
+    auto layout{ Layout::Columns };
     auto willDisplayLineLengthGraph{ false };
+    auto vocabulary{ Vocabulary::Code };
+
+    if (args.willSkipDisplay())
+    {
+        parserUPtr = std::make_unique<FileParser>(
+            reportMaker, args, commonWords, ignoredWords, flaggedWords);
+    }
+    else
+    {
+        parserUPtr = parseWhileShowingPreviews(
+            renderWin,
+            reportMaker,
+            args,
+            commonWords,
+            ignoredWords,
+            flaggedWords,
+            displayer,
+            willDisplayCounts,
+            layout);
+
+        if (!parserUPtr)
+        {
+            return EXIT_SUCCESS;
+        }
+    }
+
+    const FileParser & parser{ *parserUPtr };
 
     if (args.willSkipDisplay() == false)
     {
@@ -72,7 +121,7 @@ int main(int argc, char * argv[])
             commonWords,
             flaggedWords,
             willDisplayCounts,
-            willDisplayAsColumns);
+            layout);
     }
 
     reportMaker.echoErrors();
@@ -87,59 +136,237 @@ int main(int argc, char * argv[])
         return EXIT_SUCCESS;
     }
 
-    renderWin.setFramerateLimit(30);
+    // the scene only changes when a layout finishes, so it is drawn here once then, and the
+    // window is only redrawn from this after an event since the window may have been covered
+    sf::RenderTexture sceneTexture;
+
+    M_LOG_AND_ASSERT_OR_THROW(
+        (sceneTexture.create(renderWin.getSize().x, renderWin.getSize().y)),
+        "sf::RenderTexture::create(width=" << renderWin.getSize().x << ", height="
+                                           << renderWin.getSize().y << ") failed.");
+
+    const sf::Sprite SCENE_SPRITE(sceneTexture.getTexture());
+
+    auto willRenderScene{ true };
+
+    // only counted while no layout is pending, so this is the cost of waiting for input
+    std::clock_t idleCpuTicks{ 0 };
+    std::chrono::steady_clock::duration idleWallTime{ 0 };
+    std::size_t frameCount{ 0 };
+    std::size_t sceneRenderCount{ 0 };
+    std::chrono::steady_clock::duration sceneRenderTime{ 0 };
+    std::chrono::steady_clock::duration sceneRenderTimeMax{ 0 };
+
+    auto isDraggingCanvas{ false };
+    sf::Vector2f dragPos{ 0.0f, 0.0f };
+
+    auto isLayoutPending{ displayer.isSetupPending() };
 
     while (renderWin.isOpen())
     {
+        auto const IS_IDLE{ !isLayoutPending };
+        auto const CPU_START{ std::clock() };
+        auto const WALL_START{ std::chrono::steady_clock::now() };
+
+        // blocks until there is something to do, unless a layout needs to be checked on
         sf::Event event;
-        while (renderWin.pollEvent(event))
+        auto hasEvent{ (IS_IDLE) ? renderWin.waitEvent(event) : renderWin.pollEvent(event) };
+        auto willDrawFrame{ hasEvent };
+
+        if (!hasEvent)
+        {
+            sf::sleep(sf::milliseconds(10));
+        }
+
+        while (hasEvent)
         {
             if ((event.type == sf::Event::KeyReleased) && (event.key.code == sf::Keyboard::Space))
             {
                 willDisplayCounts = !willDisplayCounts;
 
-                displayer.setup(
-                    reportMaker,
+                displayer.requestSetup(
                     args,
                     parser,
                     commonWords,
                     flaggedWords,
                     willDisplayCounts,
-                    willDisplayAsColumns);
+                    layout,
+                    false,
+                    vocabulary);
             }
 
             if ((event.type == sf::Event::KeyReleased) && (event.key.code == sf::Keyboard::R))
             {
+                using namespace std::chrono;
+
+                auto const IDLE_CPU_SEC{ static_cast<double>(idleCpuTicks) / CLOCKS_PER_SEC };
+                auto const IDLE_WALL_SEC{ duration<double>(idleWallTime).count() };
+
+                auto const RENDER_SEC{ duration<double>(sceneRenderTime).count() };
+
+                auto const RENDER_SEC_AVERAGE{
+                    (sceneRenderCount > 0) ? (RENDER_SEC / static_cast<double>(sceneRenderCount))
+                                           : 0.0
+                };
+
+                // the loop used to redraw the whole scene at its 30 frame a second limit even
+                // when nothing changed.  This is only a modeled lower bound for what the same
+                // idle time would have cost, since it uses the render time of the batched scene,
+                // and the old loop drew up to 1000 separate sf::Text objects and rebuilt the
+                // line length graph every frame.
+                auto const OLD_LOOP_FRAMES_PER_SEC{ 30.0 };
+
+                auto const OLD_IDLE_CORE_RATIO_MIN{ std::min(
+                    1.0, (OLD_LOOP_FRAMES_PER_SEC * RENDER_SEC_AVERAGE)) };
+
+                // std::clock() is wall time on windows, so this only means something elsewhere
+                reportMaker.windowStatsStreamClear();
+
+                reportMaker.windowStatsStream()
+                    << "Window Idle CPU\t=" << IDLE_CPU_SEC << "s over " << IDLE_WALL_SEC
+                    << "s idle (" << ((IDLE_WALL_SEC > 0.0) ? (IDLE_CPU_SEC / IDLE_WALL_SEC) : 0.0)
+                    << " of one core), instead of a modeled lower bound of "
+                    << (IDLE_WALL_SEC * OLD_IDLE_CORE_RATIO_MIN) << "s ("
+                    << OLD_IDLE_CORE_RATIO_MIN << " of one core) for redrawing this scene "
+                    << OLD_LOOP_FRAMES_PER_SEC << " times a second";
+
+                reportMaker.windowStatsStream() << "Window Frames Drawn\t=" << frameCount;
+                reportMaker.windowStatsStream() << "Window Scene Renders\t=" << sceneRenderCount;
+
+                reportMaker.windowStatsStream()
+                    << "Window Scene Render Time\t=average " << (RENDER_SEC_AVERAGE * 1000.0)
+                    << "ms, max " << duration<double, std::milli>(sceneRenderTimeMax).count()
+                    << "ms";
+
                 reportMaker.make();
             }
 
             if ((event.type == sf::Event::KeyReleased) && (event.key.code == sf::Keyboard::Return))
             {
-                willDisplayAsColumns = !willDisplayAsColumns;
+                layout = static_cast<Layout::Enum>(
+                    (static_cast<int>(layout) + 1) % static_cast<int>(Layout::Count));
 
-                displayer.setup(
-                    reportMaker,
+                displayer.requestSetup(
                     args,
                     parser,
                     commonWords,
                     flaggedWords,
                     willDisplayCounts,
-                    willDisplayAsColumns);
+                    layout,
+                    false,
+                    vocabulary);
             }
 
             if ((event.type == sf::Event::KeyReleased) && (event.key.code == sf::Keyboard::L))
             {
                 willDisplayLineLengthGraph = !willDisplayLineLengthGraph;
 
-                displayer.setup(
-                    reportMaker,
+                displayer.requestSetup(
+                    args,
+                    parser,
+                    commonWords,
+                    flaggedWords,
+                    willDisplayCounts,
+                    layout,
+                    willDisplayLineLengthGraph,
+                    vocabulary);
+            }
+
+            auto const IS_VOCABULARY_KEY{ (event.type == sf::Event::KeyReleased) &&
+                                          (event.key.code == sf::Keyboard::V) };
+
+            if (IS_VOCABULARY_KEY && args.willSplitVocabularies())
+            {
+                // Code always has words, so this stops
+                do
+                {
+                    vocabulary = static_cast<Vocabulary::Enum>(
+                        (static_cast<int>(vocabulary) + 1) % static_cast<int>(Vocabulary::Count));
+                } while (parser.words(vocabulary).empty());
+
+                displayer.requestSetup(
                     args,
                     parser,
                     commonWords,
                     flaggedWords,
                     willDisplayCounts,
-                    willDisplayAsColumns,
-                    willDisplayLineLengthGraph);
+                    layout,
+                    false,
+                    vocabulary);
+            }
+
+            // the canvas layout is bigger than the screen, so it can be zoomed and panned
+            if (event.type == sf::Event::MouseWheelScrolled)
+            {
+                const sf::Vector2f MOUSE_POS(
+                    static_cast<float>(event.mouseWheelScroll.x),
+                    static_cast<float>(event.mouseWheelScroll.y));
+
+                auto const ZOOM_FACTOR{ ((event.mouseWheelScroll.delta > 0.0f) ? 0.8f : 1.25f) };
+
+                if (displayer.zoomCanvas(ZOOM_FACTOR, MOUSE_POS))
+                {
+                    willRenderScene = true;
+                }
+            }
+
+            if ((event.type == sf::Event::MouseButtonPressed) &&
+                (event.mouseButton.button == sf::Mouse::Left))
+            {
+                isDraggingCanvas = true;
+
+                dragPos = sf::Vector2f(
+                    static_cast<float>(event.mouseButton.x),
+                    static_cast<float>(event.mouseButton.y));
+            }
+
+            if (event.type == sf::Event::MouseButtonReleased)
+            {
+                isDraggingCanvas = false;
+            }
+
+            if ((event.type == sf::Event::MouseMoved) && isDraggingCanvas)
+            {
+                const sf::Vector2f MOUSE_POS(
+                    static_cast<float>(event.mouseMove.x), static_cast<float>(event.mouseMove.y));
+
+                if (displayer.panCanvas(dragPos - MOUSE_POS))
+                {
+                    willRenderScene = true;
+                }
+
+                dragPos = MOUSE_POS;
+            }
+
+            if (event.type == sf::Event::KeyPressed)
+            {
+                auto const PAN_STEP{ static_cast<float>(VIDEO_MODE.height) * 0.25f };
+                sf::Vector2f panOffset{ 0.0f, 0.0f };
+
+                if (event.key.code == sf::Keyboard::Left)
+                {
+                    panOffset.x = -PAN_STEP;
+                }
+                else if (event.key.code == sf::Keyboard::Right)
+                {
+                    panOffset.x = PAN_STEP;
+                }
+                else if (event.key.code == sf::Keyboard::Up)
+                {
+                    panOffset.y = -PAN_STEP;
+                }
+                else if (event.key.code == sf::Keyboard::Down)
+                {
+                    panOffset.y = PAN_STEP;
+                }
+
+                auto const IS_PAN_KEY{ (panOffset.x < 0.0f) || (panOffset.x > 0.0f) ||
+                                       (panOffset.y < 0.0f) || (panOffset.y > 0.0f) };
+
+                if (IS_PAN_KEY && displayer.panCanvas(panOffset))
+                {
+                    willRenderScene = true;
+                }
             }
 
             auto const IS_QUIT_KEY_PRESSED{ sf::Keyboard::isKeyPressed(sf::Keyboard::Escape) ||
@@ -156,35 +383,163 @@ int main(int argc, char * argv[])
 
             if (sf::Keyboard::isKeyPressed(sf::Keyboard::S))
             {
-                saveScreenshot(renderWin);
+                saveScreenshot(sceneTexture);
             }
+
+            hasEvent = renderWin.pollEvent(event);
+        }
+
+        // checked before taking the finished scenes, so one finished after is never missed
+        isLayoutPending = displayer.isSetupPending();
+
+        // until the layout thread finishes, the last scene is drawn
+        if (displayer.updateScene(reportMaker))
+        {
+            willRenderScene = true;
         }
 
-        renderWin.clear(sf::Color::Black);
+        if (willRenderScene)
+        {
+            auto const RENDER_START{ std::chrono::steady_clock::now() };
+
+            sceneTexture.clear(sf::Color::Black);
+
+            sf::RenderStates states;
+            displayer.draw(sceneTexture, states);
 
-        sf::RenderStates states;
-        displayer.draw(args, parser, renderWin, states);
+            sceneTexture.display();
+            willRenderScene = false;
+            willDrawFrame = true;
+            ++sceneRenderCount;
+
+            auto const RENDER_DURATION{ std::chrono::steady_clock::now() - RENDER_START };
+            sceneRenderTime += RENDER_DURATION;
+            sceneRenderTimeMax = std::max(sceneRenderTimeMax, RENDER_DURATION);
+        }
 
-        renderWin.display();
+        if (willDrawFrame && renderWin.isOpen())
+        {
+            renderWin.clear(sf::Color::Black);
+            renderWin.draw(SCENE_SPRITE);
+            renderWin.display();
+            ++frameCount;
+        }
+
+        if (IS_IDLE)
+        {
+            idleCpuTicks += (std::clock() - CPU_START);
+            idleWallTime += (std::chrono::steady_clock::now() - WALL_START);
+        }
     }
 
     return EXIT_SUCCESS;
 }
 
-void saveScreenshot(sf::RenderWindow & renderWin)
+std::unique_ptr<FileParser> parseWhileShowingPreviews(
+    sf::RenderWindow & renderWin,
+    ReportMaker & reportMaker,
+    const ArgsParser & ARGS,
+    const WordList & COMMON_WORDS,
+    const WordList & IGNORED_WORDS,
+    const WordList & FLAGGED_WORDS,
+    ParseDisplayer & displayer,
+    const bool WILL_SHOW_COUNTS,
+    const Layout::Enum LAYOUT)
 {
-    const sf::Vector2u WINDOW_SIZE{ renderWin.getSize() };
+    // a preview is laid out at most this often, and never while the last is still being laid out
+    const std::chrono::milliseconds PREVIEW_INTERVAL(500);
 
-    sf::Texture texture;
+    ParseProgress progress;
+    std::unique_ptr<FileParser> parserUPtr;
+    std::exception_ptr errorPtr;
 
-    M_LOG_AND_ASSERT_OR_THROW(
-        (texture.create(WINDOW_SIZE.x, WINDOW_SIZE.y)),
-        "Unable to take screenshot.  sf::Texture::create(width=" << WINDOW_SIZE.x << ", height="
-                                                                 << WINDOW_SIZE.y << ") failed.");
+    std::thread parseThread([&]() {
+        try
+        {
+            parserUPtr = std::make_unique<FileParser>(
+                reportMaker, ARGS, COMMON_WORDS, IGNORED_WORDS, FLAGGED_WORDS, &progress);
+        }
+        catch (...)
+        {
+            errorPtr = std::current_exception();
+        }
+
+        progress.finish();
+    });
+
+    // the parse thread is writing to reportMaker, and the stats of a preview are not kept anyway
+    ReportMaker previewReportMaker;
 
-    texture.update(renderWin);
+    WordCountVec_t snapshotWords;
+    std::size_t previewVersion{ 0 };
+    auto previewTime{ std::chrono::steady_clock::now() - PREVIEW_INTERVAL };
 
-    auto const SCREENSHOT_IMAGE{ texture.copyToImage() };
+    while (progress.isFinished() == false)
+    {
+        sf::Event event;
+        while (renderWin.pollEvent(event))
+        {
+            auto const IS_QUIT_KEY_PRESSED{ (event.type == sf::Event::KeyPressed) &&
+                                            ((event.key.code == sf::Keyboard::Escape) ||
+                                             (event.key.code == sf::Keyboard::Q)) };
+
+            if (IS_QUIT_KEY_PRESSED || (event.type == sf::Event::Closed))
+            {
+                progress.cancel();
+                renderWin.close();
+            }
+        }
+
+        auto const NOW{ std::chrono::steady_clock::now() };
+
+        auto const IS_PREVIEW_DUE{ (progress.version() != previewVersion) &&
+                                   ((NOW - previewTime) >= PREVIEW_INTERVAL) &&
+                                   (displayer.isSetupPending() == false) };
+
+        if (IS_PREVIEW_DUE)
+        {
+            previewVersion = progress.snapshot(snapshotWords);
+            previewTime = NOW;
+
+            displayer.requestPreview(
+                ARGS, snapshotWords, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, LAYOUT);
+        }
+
+        displayer.updateScene(previewReportMaker);
+
+        // the progress bar changes all the time, so this is drawn every time around
+        if (renderWin.isOpen())
+        {
+            sf::RenderStates states;
+            renderWin.clear(sf::Color::Black);
+            displayer.draw(renderWin, states);
+            displayer.drawParseProgress(renderWin, states, progress);
+            renderWin.display();
+        }
+
+        sf::sleep(sf::milliseconds(50));
+    }
+
+    parseThread.join();
+
+    if (errorPtr)
+    {
+        std::rethrow_exception(errorPtr);
+    }
+
+    if (progress.isCancelled())
+    {
+        return nullptr;
+    }
+
+    return parserUPtr;
+}
+
+void saveScreenshot(const sf::RenderTexture & SCENE_TEXTURE)
+{
+    // the window's back buffer is not redrawn every frame anymore, but the scene texture is
+    // always what was last shown
+    auto const SCREENSHOT_IMAGE{ SCENE_TEXTURE.getTexture().copyToImage() };
 
     auto const FILENAME_BASE{ "screenshot" };
     auto const FILENAME_EXT{ ".png" };
@@ -0,0 +1,249 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// occupancy-bitmap.cpp
+//
+#include "occupancy-bitmap.hpp"
+
+#include <algorithm>
+
+namespace word_stacker
+{
+
+    OccupancyBitmap::OccupancyBitmap(
+        const std::size_t WIDTH, const std::size_t HEIGHT, const std::size_t LEVEL_COUNT)
+        : m_levels()
+        , m_fineTestCount(0)
+    {
+        m_levels.push_back(makeLevel(WIDTH, HEIGHT));
+
+        while (m_levels.size() < LEVEL_COUNT)
+        {
+            auto const & FINER_LEVEL{ m_levels.back() };
+            m_levels.push_back(
+                makeLevel(((FINER_LEVEL.width + 3) / 4), ((FINER_LEVEL.height + 3) / 4)));
+        }
+    }
+
+    void OccupancyBitmap::fill(const long LEFT, const long TOP, const long RIGHT, const long BOTTOM)
+    {
+        for (std::size_t index(0); index < m_levels.size(); ++index)
+        {
+            // floor the start and ceiling the end, so the coarse cells cover every fine one
+            auto const SHIFT{ static_cast<long>(index * 2) };
+            auto const ROUND_UP{ (1L << SHIFT) - 1 };
+
+            fillLevel(
+                m_levels[index],
+                (std::max(0L, LEFT) >> SHIFT),
+                (std::max(0L, TOP) >> SHIFT),
+                ((std::max(0L, RIGHT) + ROUND_UP) >> SHIFT),
+                ((std::max(0L, BOTTOM) + ROUND_UP) >> SHIFT));
+        }
+    }
+
+    bool OccupancyBitmap::overlaps(
+        const OccupancyBitmap & SPRITE,
+        const std::size_t LEFT,
+        const std::size_t TOP,
+        std::size_t & overlapLeft,
+        std::size_t & overlapTop) const
+    {
+        // an empty coarse cell means all the fine cells under it are empty, so start at the
+        // coarsest level and only AND the sprite in if every level says something is near
+        for (auto index{ m_levels.size() }; index > 1; --index)
+        {
+            if (isEmpty(
+                    (index - 1),
+                    LEFT,
+                    TOP,
+                    (LEFT + SPRITE.width()),
+                    (TOP + SPRITE.height())))
+            {
+                return false;
+            }
+        }
+
+        ++m_fineTestCount;
+
+        auto const & LEVEL{ m_levels.front() };
+        auto const & SPRITE_LEVEL{ SPRITE.m_levels.front() };
+
+        auto const WORD_OFFSET{ LEFT / 64 };
+        auto const BIT_SHIFT{ LEFT % 64 };
+
+        for (std::size_t row(0); row < SPRITE_LEVEL.height; ++row)
+        {
+            auto const SPRITE_ROW_BEGIN{ row * SPRITE_LEVEL.wordsPerRow };
+            auto const ROW_BEGIN{ ((TOP + row) * LEVEL.wordsPerRow) + WORD_OFFSET };
+
+            // the bits shifted out of the top of one sprite word go into the bottom of the next
+            std::uint64_t carry{ 0 };
+
+            for (std::size_t column(0); column <= SPRITE_LEVEL.wordsPerRow; ++column)
+            {
+                if ((WORD_OFFSET + column) >= LEVEL.wordsPerRow)
+                {
+                    break;
+                }
+
+                auto const SPRITE_WORD{ (column < SPRITE_LEVEL.wordsPerRow)
+                                            ? SPRITE_LEVEL.words[SPRITE_ROW_BEGIN + column]
+                                            : 0 };
+
+                auto const SHIFTED_WORD{ (SPRITE_WORD << BIT_SHIFT) | carry };
+                carry = ((0 == BIT_SHIFT) ? 0 : (SPRITE_WORD >> (64 - BIT_SHIFT)));
+
+                auto const OVERLAP_WORD{ SHIFTED_WORD & LEVEL.words[ROW_BEGIN + column] };
+
+                if (OVERLAP_WORD)
+                {
+                    std::size_t bit{ 0 };
+
+                    while (((OVERLAP_WORD >> bit) & std::uint64_t(1)) == 0)
+                    {
+                        ++bit;
+                    }
+
+                    overlapLeft = (((WORD_OFFSET + column) * 64) + bit);
+                    overlapTop = (TOP + row);
+                    return true;
+                }
+            }
+        }
+
+        return false;
+    }
+
+    void OccupancyBitmap::add(
+        const OccupancyBitmap & SPRITE, const std::size_t LEFT, const std::size_t TOP)
+    {
+        auto & level{ m_levels.front() };
+        auto const & SPRITE_LEVEL{ SPRITE.m_levels.front() };
+
+        auto const WORD_OFFSET{ LEFT / 64 };
+        auto const BIT_SHIFT{ LEFT % 64 };
+
+        for (std::size_t row(0); row < SPRITE_LEVEL.height; ++row)
+        {
+            auto const SPRITE_ROW_BEGIN{ row * SPRITE_LEVEL.wordsPerRow };
+            auto const ROW_BEGIN{ ((TOP + row) * level.wordsPerRow) + WORD_OFFSET };
+
+            std::uint64_t carry{ 0 };
+
+            for (std::size_t column(0); column <= SPRITE_LEVEL.wordsPerRow; ++column)
+            {
+                if ((WORD_OFFSET + column) >= level.wordsPerRow)
+                {
+                    break;
+                }
+
+                auto const SPRITE_WORD{ (column < SPRITE_LEVEL.wordsPerRow)
+                                            ? SPRITE_LEVEL.words[SPRITE_ROW_BEGIN + column]
+                                            : 0 };
+
+                level.words[ROW_BEGIN + column] |= ((SPRITE_WORD << BIT_SHIFT) | carry);
+                carry = ((0 == BIT_SHIFT) ? 0 : (SPRITE_WORD >> (64 - BIT_SHIFT)));
+            }
+        }
+
+        // the coarse levels only mark the sprite's whole rect, which can only make them say
+        // something is near when it is not, and that only costs a fine test
+        for (std::size_t index(1); index < m_levels.size(); ++index)
+        {
+            auto const SHIFT{ static_cast<long>(index * 2) };
+            auto const ROUND_UP{ (1L << SHIFT) - 1 };
+
+            fillLevel(
+                m_levels[index],
+                (static_cast<long>(LEFT) >> SHIFT),
+                (static_cast<long>(TOP) >> SHIFT),
+                ((static_cast<long>(LEFT + SPRITE.width()) + ROUND_UP) >> SHIFT),
+                ((static_cast<long>(TOP + SPRITE.height()) + ROUND_UP) >> SHIFT));
+        }
+    }
+
+    OccupancyBitmap::Level
+        OccupancyBitmap::makeLevel(const std::size_t WIDTH, const std::size_t HEIGHT)
+    {
+        Level level;
+        level.width = std::max(std::size_t(1), WIDTH);
+        level.height = std::max(std::size_t(1), HEIGHT);
+        level.wordsPerRow = ((level.width + 63) / 64);
+        level.words.resize((level.wordsPerRow * level.height), 0);
+        return level;
+    }
+
+    void OccupancyBitmap::fillLevel(
+        Level & level, const long LEFT, const long TOP, const long RIGHT, const long BOTTOM)
+    {
+        auto const LEFT_CLIPPED{ std::min(static_cast<std::size_t>(LEFT), level.width) };
+        auto const RIGHT_CLIPPED{ std::min(static_cast<std::size_t>(RIGHT), level.width) };
+        auto const TOP_CLIPPED{ std::min(static_cast<std::size_t>(TOP), level.height) };
+        auto const BOTTOM_CLIPPED{ std::min(static_cast<std::size_t>(BOTTOM), level.height) };
+
+        for (auto row{ TOP_CLIPPED }; row < BOTTOM_CLIPPED; ++row)
+        {
+            auto const ROW_BEGIN{ row * level.wordsPerRow };
+
+            for (auto column{ LEFT_CLIPPED }; column < RIGHT_CLIPPED; ++column)
+            {
+                level.words[ROW_BEGIN + (column / 64)] |= (std::uint64_t(1) << (column % 64));
+            }
+        }
+    }
+
+    bool OccupancyBitmap::isEmpty(
+        const std::size_t LEVEL_INDEX,
+        const std::size_t LEFT,
+        const std::size_t TOP,
+        const std::size_t RIGHT,
+        const std::size_t BOTTOM) const
+    {
+        auto const & LEVEL{ m_levels[LEVEL_INDEX] };
+        auto const SHIFT{ LEVEL_INDEX * 2 };
+        auto const ROUND_UP{ (std::size_t(1) << SHIFT) - 1 };
+
+        auto const COLUMN_BEGIN{ std::min((LEFT >> SHIFT), LEVEL.width) };
+        auto const COLUMN_END{ std::min(((RIGHT + ROUND_UP) >> SHIFT), LEVEL.width) };
+        auto const ROW_BEGIN{ std::min((TOP >> SHIFT), LEVEL.height) };
+        auto const ROW_END{ std::min(((BOTTOM + ROUND_UP) >> SHIFT), LEVEL.height) };
+
+        if ((COLUMN_BEGIN >= COLUMN_END) || (ROW_BEGIN >= ROW_END))
+        {
+            return true;
+        }
+
+        auto const WORD_FIRST{ COLUMN_BEGIN / 64 };
+        auto const WORD_LAST{ (COLUMN_END - 1) / 64 };
+
+        for (auto row{ ROW_BEGIN }; row < ROW_END; ++row)
+        {
+            auto const ROW_WORDS_BEGIN{ row * LEVEL.wordsPerRow };
+
+            for (auto wordIndex{ WORD_FIRST }; wordIndex <= WORD_LAST; ++wordIndex)
+            {
+                // only the bits from COLUMN_BEGIN up to COLUMN_END in this word
+                std::uint64_t mask{ ~std::uint64_t(0) };
+
+                if (wordIndex == WORD_FIRST)
+                {
+                    mask &= (~std::uint64_t(0) << (COLUMN_BEGIN % 64));
+                }
+
+                if ((wordIndex == WORD_LAST) && ((COLUMN_END % 64) != 0))
+                {
+                    mask &= (~std::uint64_t(0) >> (64 - (COLUMN_END % 64)));
+                }
+
+                if (LEVEL.words[ROW_WORDS_BEGIN + wordIndex] & mask)
+                {
+                    return false;
+                }
+            }
+        }
+
+        return true;
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,95 @@
+#ifndef WORDSTACKER_OCCUPANCYBITMAP_HPP_INCLUDED
+#define WORDSTACKER_OCCUPANCYBITMAP_HPP_INCLUDED
+//
+// occupancy-bitmap.hpp
+//
+#include <cstddef> //for std::size_t
+#include <cstdint>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for keeping track of which cells of an area are covered, one bit per cell, in
+    // rows of 64-bit words so that testing a sprite against it is one AND per 64 cells.  Each of
+    // the coarser levels has one bit for every 4x4 bits of the level below it, set if any of
+    // those might be covered, so most of an empty area is found to be empty without looking at
+    // the sprite at all.  A sprite is just an OccupancyBitmap with one level.
+    class OccupancyBitmap
+    {
+      public:
+        OccupancyBitmap(
+            const std::size_t WIDTH, const std::size_t HEIGHT, const std::size_t LEVEL_COUNT = 1);
+
+        inline std::size_t width() const { return m_levels.front().width; }
+        inline std::size_t height() const { return m_levels.front().height; }
+
+        inline bool isCovered(const std::size_t LEFT, const std::size_t TOP) const
+        {
+            auto const & LEVEL{ m_levels.front() };
+
+            return (
+                ((LEVEL.words[(TOP * LEVEL.wordsPerRow) + (LEFT / 64)] >> (LEFT % 64)) &
+                 std::uint64_t(1)) != 0);
+        }
+
+        // covers the cells from LEFT/TOP up to but not including RIGHT/BOTTOM, clipped
+        void fill(const long LEFT, const long TOP, const long RIGHT, const long BOTTOM);
+
+        // true if any cell covered in SPRITE is covered here, with SPRITE moved to LEFT/TOP,
+        // which must keep all of SPRITE inside
+        inline bool overlaps(
+            const OccupancyBitmap & SPRITE, const std::size_t LEFT, const std::size_t TOP) const
+        {
+            std::size_t overlapLeft{ 0 };
+            std::size_t overlapTop{ 0 };
+            return overlaps(SPRITE, LEFT, TOP, overlapLeft, overlapTop);
+        }
+
+        // like overlaps() but also sets overlapLeft/overlapTop to the first cell here that is
+        // covered in both, if there is one
+        bool overlaps(
+            const OccupancyBitmap & SPRITE,
+            const std::size_t LEFT,
+            const std::size_t TOP,
+            std::size_t & overlapLeft,
+            std::size_t & overlapTop) const;
+
+        // covers every cell covered in SPRITE, with SPRITE moved to LEFT/TOP as in overlaps()
+        void add(const OccupancyBitmap & SPRITE, const std::size_t LEFT, const std::size_t TOP);
+
+        // how many overlaps() calls had to AND the sprite, and not just look at coarser levels
+        inline std::size_t fineTestCount() const { return m_fineTestCount; }
+
+      private:
+        // Responsible for wrapping one level of bits.
+        struct Level
+        {
+            std::size_t width = 0;
+            std::size_t height = 0;
+            std::size_t wordsPerRow = 0;
+            std::vector<std::uint64_t> words{};
+        };
+
+        static Level makeLevel(const std::size_t WIDTH, const std::size_t HEIGHT);
+
+        static void fillLevel(
+            Level & level, const long LEFT, const long TOP, const long RIGHT, const long BOTTOM);
+
+        // true if no bit is set in the cells of LEVEL_INDEX that cover the level zero cells
+        // from LEFT/TOP up to but not including RIGHT/BOTTOM
+        bool isEmpty(
+            const std::size_t LEVEL_INDEX,
+            const std::size_t LEFT,
+            const std::size_t TOP,
+            const std::size_t RIGHT,
+            const std::size_t BOTTOM) const;
+
+      private:
+        std::vector<Level> m_levels;
+        mutable std::size_t m_fineTestCount;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_OCCUPANCYBITMAP_HPP_INCLUDED
@@ -0,0 +1,87 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// parse-counts.cpp
+//
+#include "parse-counts.hpp"
+
+namespace word_stacker
+{
+
+    void ParseCounts::merge(const ParseCounts & OTHER)
+    {
+        mergeCopies(OTHER, 1);
+
+        fileLineSummaries.insert(
+            std::end(fileLineSummaries),
+            std::begin(OTHER.fileLineSummaries),
+            std::end(OTHER.fileLineSummaries));
+    }
+
+    void ParseCounts::mergeCopies(const ParseCounts & OTHER, const std::size_t COPY_COUNT)
+    {
+        for (auto const & PAIR : OTHER.wordCountMap)
+        {
+            wordCountMap[PAIR.first] += (PAIR.second * COPY_COUNT);
+        }
+
+        for (auto const & PAIR : OTHER.commentWordCountMap)
+        {
+            commentWordCountMap[PAIR.first] += (PAIR.second * COPY_COUNT);
+        }
+
+        for (auto const & PAIR : OTHER.stringWordCountMap)
+        {
+            stringWordCountMap[PAIR.first] += (PAIR.second * COPY_COUNT);
+        }
+
+        lineMetrics.merge(OTHER.lineMetrics, COPY_COUNT);
+
+        for (auto const & PAIR : OTHER.extensionLineMetrics)
+        {
+            extensionLineMetrics[PAIR.first].merge(PAIR.second, COPY_COUNT);
+        }
+
+        lineCount += (OTHER.lineCount * COPY_COUNT);
+        unCLineCount += (OTHER.unCLineCount * COPY_COUNT);
+        singleCount += (OTHER.singleCount * COPY_COUNT);
+        ignoredCount += (OTHER.ignoredCount * COPY_COUNT);
+        fileCount += (OTHER.fileCount * COPY_COUNT);
+        flaggedCount += (OTHER.flaggedCount * COPY_COUNT);
+        overlongCount += (OTHER.overlongCount * COPY_COUNT);
+        splitIdentifierCount += (OTHER.splitIdentifierCount * COPY_COUNT);
+    }
+
+    void ParseCounts::endFile(const std::string & PATH)
+    {
+        lineMetrics.merge(fileLineMetrics);
+
+        if (!PATH.empty() && !fileLineMetrics.empty())
+        {
+            extensionLineMetrics[extension(PATH)].merge(fileLineMetrics);
+
+            FileLineSummary fileLineSummary;
+            fileLineSummary.path = PATH;
+            fileLineSummary.summary = fileLineMetrics.summarize();
+            fileLineSummaries.push_back(fileLineSummary);
+        }
+
+        fileLineMetrics.clear();
+    }
+
+    std::string ParseCounts::extension(const std::string & PATH)
+    {
+        auto const NAME_POS{ PATH.find_last_of('/') };
+        auto const DOT_POS{ PATH.find_last_of('.') };
+
+        // a leading dot is a hidden file and not an extension
+        if ((DOT_POS == std::string::npos) || (DOT_POS == 0) ||
+            ((NAME_POS != std::string::npos) && (DOT_POS <= (NAME_POS + 1))))
+        {
+            return "";
+        }
+
+        return PATH.substr(DOT_POS);
+    }
+
+} // namespace word_stacker
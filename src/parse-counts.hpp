@@ -0,0 +1,97 @@
+#ifndef WORDSTACKER_PARSECOUNTS_HPP_INCLUDED
+#define WORDSTACKER_PARSECOUNTS_HPP_INCLUDED
+//
+// parse-counts.hpp
+//
+#include "line-metrics.hpp"
+#include "vocabulary-enum.hpp"
+
+#include <cstddef> //for std::size_t
+#include <map>
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    using WordCountMap_t = std::map<std::string, std::size_t>;
+
+    // Responsible for wrapping everything counted while parsing.  Each tokenizing thread fills its
+    // own so that no mutable state is shared between threads, and they are all merged at the end.
+    struct ParseCounts
+    {
+        ParseCounts()
+            : wordCountMap()
+            , commentWordCountMap()
+            , stringWordCountMap()
+            , lineMetrics()
+            , fileLineMetrics()
+            , extensionLineMetrics()
+            , fileLineSummaries()
+            , lineCount(0)
+            , unCLineCount(0)
+            , singleCount(0)
+            , ignoredCount(0)
+            , fileCount(0)
+            , flaggedCount(0)
+            , overlongCount(0)
+            , splitIdentifierCount(0)
+        {}
+
+        // adds everything in OTHER, including the summary of each file in it
+        void merge(const ParseCounts & OTHER);
+
+        // adds the counts in OTHER COPY_COUNT times, as if that many more copies of its files
+        // were parsed, but their summaries are not listed again since they would be the same
+        void mergeCopies(const ParseCounts & OTHER, const std::size_t COPY_COUNT);
+
+        inline WordCountMap_t & wordCountMapFor(const Vocabulary::Enum VOCABULARY)
+        {
+            if (VOCABULARY == Vocabulary::Comments)
+            {
+                return commentWordCountMap;
+            }
+
+            if (VOCABULARY == Vocabulary::Strings)
+            {
+                return stringWordCountMap;
+            }
+
+            return wordCountMap;
+        }
+
+        // moves the lines of the file just tokenized from fileLineMetrics into the totals and
+        // the breakdowns, an empty PATH means the text was not one file and is only totaled
+        void endFile(const std::string & PATH);
+
+        // the extension including the dot, or an empty string
+        static std::string extension(const std::string & PATH);
+
+        WordCountMap_t wordCountMap;
+
+        // only filled when code is split into vocabularies, see ArgsParser::willSplitVocabularies()
+        WordCountMap_t commentWordCountMap;
+        WordCountMap_t stringWordCountMap;
+
+        LineMetrics lineMetrics;
+
+        // the lines of the file being tokenized, until endFile()
+        LineMetrics fileLineMetrics;
+
+        std::map<std::string, LineMetrics> extensionLineMetrics;
+        std::vector<FileLineSummary> fileLineSummaries;
+        std::size_t lineCount;
+        std::size_t unCLineCount;
+        std::size_t singleCount;
+        std::size_t ignoredCount;
+        std::size_t fileCount;
+        std::size_t flaggedCount;
+        std::size_t overlongCount;
+
+        // identifiers that had more than one part, see ArgsParser::willSplitIdentifiers()
+        std::size_t splitIdentifierCount;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_PARSECOUNTS_HPP_INCLUDED
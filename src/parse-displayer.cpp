@@ -7,15 +7,31 @@
 #include "parse-displayer.hpp"
 #include "word-count-stats.hpp"
 
+#include <boost/algorithm/string.hpp>
+
 #include <filesystem>
 
 #include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <set>
 #include <sstream>
 
 namespace word_stacker
 {
 
     const std::size_t ParseDisplayer::M_GRADIENT_DEPTH{ 4096 };
+    const float ParseDisplayer::M_JUMBLE_GRID_CELL_SIZE{ 64.0f };
+    const float ParseDisplayer::M_SPIRAL_CELL_SIZE{ 2.0f };
+    const std::size_t ParseDisplayer::M_SPIRAL_LEVEL_COUNT{ 3 };
+
+    // about 19% apart, so a few dozen texture pages cover every size instead of hundreds
+    const unsigned ParseDisplayer::M_FONT_SIZES_PER_DOUBLING{ 4 };
+
+    const std::size_t ParseDisplayer::M_CANVAS_WORD_COUNT_MAX{ 100000 };
+
+    // canvas units for each pixel, so a quarter is four times closer than the layout
+    const float ParseDisplayer::M_CANVAS_ZOOM_IN_MAX{ 0.25f };
 
     ParseDisplayer::ParseDisplayer(const ArgsParser & ARGS)
         : m_uniqueColors(
@@ -24,8 +40,24 @@ namespace word_stacker
               M_GRADIENT_DEPTH)
         , m_commonColors()
         , m_font()
-        , m_texts()
-        , m_willShowLineLengthGraph(false)
+        , m_fontFace(m_font)
+        , m_glyphMetrics(m_fontFace, M_FONT_SIZES_PER_DOUBLING)
+        , m_sceneCache()
+        , m_sceneKey()
+        , m_shownScenePtr(nullptr)
+        , m_screenSize(ARGS.screenWidthF(), ARGS.screenHeightF())
+        , m_canvasView(sf::FloatRect(0.0f, 0.0f, ARGS.screenWidthF(), ARGS.screenHeightF()))
+        , m_layoutFontFace()
+        , m_layoutGlyphMetrics(m_layoutFontFace, M_FONT_SIZES_PER_DOUBLING)
+        , m_layoutSceneUPtr()
+        , m_fontSizeMax(0)
+        , m_layoutPassCount(0)
+        , m_layoutPlacements()
+        , m_placementRecords()
+        , m_lastPlacementCount(0)
+        , m_changedPlacementCount(0)
+        , m_keptPlacementCount(0)
+        , m_layoutWorker()
     {
         // create a brown-orange-yellow-white color gradient
         ColorRangeVec_t colorRanges = {
@@ -48,78 +80,507 @@ namespace word_stacker
         }
     }
 
-    void ParseDisplayer::draw(
+    void ParseDisplayer::draw(sf::RenderTarget & target, sf::RenderStates states) const
+    {
+        if (nullptr == m_shownScenePtr)
+        {
+            return;
+        }
+
+        // the canvas only draws what is in the view of target, so it is given the canvas view
+        if (m_shownScenePtr->canvasUPtr)
+        {
+            auto const VIEW{ target.getView() };
+            target.setView(m_canvasView);
+            target.draw(*m_shownScenePtr->canvasUPtr, states);
+            target.setView(VIEW);
+            return;
+        }
+
+        // only the line length graph has shapes, and they were all made with the scene
+        auto const & SCENE{ *m_shownScenePtr->sceneUPtr };
+
+        if (SCENE.lineVerts().empty() == false)
+        {
+            target.draw(&SCENE.lineVerts()[0], SCENE.lineVerts().size(), sf::Lines, states);
+        }
+
+        if (SCENE.quadVerts().empty() == false)
+        {
+            target.draw(&SCENE.quadVerts()[0], SCENE.quadVerts().size(), sf::Quads, states);
+        }
+
+        target.draw(*m_shownScenePtr->textBatchUPtr, states);
+    }
+
+    bool ParseDisplayer::isShowingCanvas() const
+    {
+        return ((nullptr != m_shownScenePtr) && m_shownScenePtr->canvasUPtr);
+    }
+
+    bool ParseDisplayer::zoomCanvas(const float FACTOR, const sf::Vector2f & SCREEN_POS)
+    {
+        if (isShowingCanvas() == false)
+        {
+            return false;
+        }
+
+        // the part of the canvas under SCREEN_POS stays there
+        auto const UNITS_PER_PIXEL{ m_canvasView.getSize().x / m_screenSize.x };
+        auto const TOP_LEFT{ m_canvasView.getCenter() - (m_canvasView.getSize() * 0.5f) };
+        auto const CANVAS_POS{ TOP_LEFT + (SCREEN_POS * UNITS_PER_PIXEL) };
+
+        // from four times closer than the layout to far enough away to see all of it
+        auto const & CANVAS_SIZE{ m_shownScenePtr->canvasUPtr->size() };
+
+        auto const ZOOM_OUT_MAX{ std::max(
+            1.0f, std::max((CANVAS_SIZE.x / m_screenSize.x), (CANVAS_SIZE.y / m_screenSize.y))) };
+
+        auto const NEW_UNITS_PER_PIXEL{ std::clamp(
+            (UNITS_PER_PIXEL * FACTOR), M_CANVAS_ZOOM_IN_MAX, ZOOM_OUT_MAX) };
+
+        m_canvasView.setSize(m_screenSize * NEW_UNITS_PER_PIXEL);
+
+        m_canvasView.setCenter(
+            (CANVAS_POS - (SCREEN_POS * NEW_UNITS_PER_PIXEL)) + (m_canvasView.getSize() * 0.5f));
+
+        clampCanvasView();
+        return true;
+    }
+
+    bool ParseDisplayer::panCanvas(const sf::Vector2f & SCREEN_OFFSET)
+    {
+        if (isShowingCanvas() == false)
+        {
+            return false;
+        }
+
+        m_canvasView.move(SCREEN_OFFSET * (m_canvasView.getSize().x / m_screenSize.x));
+        clampCanvasView();
+        return true;
+    }
+
+    void ParseDisplayer::clampCanvasView()
+    {
+        // the center is kept on the canvas, so some of it is always in view
+        auto const & CANVAS_SIZE{ m_shownScenePtr->canvasUPtr->size() };
+        auto const & CENTER{ m_canvasView.getCenter() };
+
+        m_canvasView.setCenter(
+            std::clamp(CENTER.x, 0.0f, CANVAS_SIZE.x), std::clamp(CENTER.y, 0.0f, CANVAS_SIZE.y));
+    }
+
+    void ParseDisplayer::drawParseProgress(
+        sf::RenderTarget & target, sf::RenderStates states, const ParseProgress & PROGRESS) const
+    {
+        auto const BAR_HEIGHT{ std::max(4.0f, (m_screenSize.y * 0.01f)) };
+        auto const BAR_TOP{ m_screenSize.y - BAR_HEIGHT };
+        auto const DONE_RIGHT{ m_screenSize.x * PROGRESS.ratio() };
+
+        const sf::Color LEFT_COLOR(64, 64, 64);
+        auto const DONE_COLOR{ m_uniqueColors.colorAtRatio(1.0f) };
+
+        const std::vector<sf::Vertex> VERTS = {
+            sf::Vertex(sf::Vector2f(DONE_RIGHT, BAR_TOP), LEFT_COLOR),
+            sf::Vertex(sf::Vector2f(m_screenSize.x, BAR_TOP), LEFT_COLOR),
+            sf::Vertex(sf::Vector2f(m_screenSize.x, m_screenSize.y), LEFT_COLOR),
+            sf::Vertex(sf::Vector2f(DONE_RIGHT, m_screenSize.y), LEFT_COLOR),
+            sf::Vertex(sf::Vector2f(0.0f, BAR_TOP), DONE_COLOR),
+            sf::Vertex(sf::Vector2f(DONE_RIGHT, BAR_TOP), DONE_COLOR),
+            sf::Vertex(sf::Vector2f(DONE_RIGHT, m_screenSize.y), DONE_COLOR),
+            sf::Vertex(sf::Vector2f(0.0f, m_screenSize.y), DONE_COLOR)
+        };
+
+        target.draw(&VERTS[0], VERTS.size(), sf::Quads, states);
+
+        // more files may still be found until the walk is done, hence the plus
+        std::ostringstream ss;
+        ss << "Parsed " << PROGRESS.doneFileCount() << " of " << PROGRESS.foundFileCount()
+           << ((PROGRESS.isDiscoveryFinished()) ? "" : "+") << " files, "
+           << (PROGRESS.doneByteCount() / (1024 * 1024)) << "MB";
+
+        const unsigned FONT_SIZE{ 20 };
+        sf::Text text(ss.str(), m_font, FONT_SIZE);
+        text.setFillColor(DONE_COLOR);
+
+        auto const BOUNDS{ text.getLocalBounds() };
+
+        text.setPosition(
+            (BAR_HEIGHT - BOUNDS.left), (BAR_TOP - BAR_HEIGHT - BOUNDS.height - BOUNDS.top));
+
+        target.draw(text, states);
+    }
+
+    void ParseDisplayer::setup(
+        ReportMaker & reportMaker,
         const ArgsParser & ARGS,
         const FileParser & PARSED_FILE,
-        sf::RenderTarget & target,
-        sf::RenderStates states) const
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        const Layout::Enum LAYOUT,
+        const bool WILL_SHOW_LINELEN_GRAPH,
+        const Vocabulary::Enum VOCABULARY)
     {
-        if (m_willShowLineLengthGraph)
+        requestSetup(
+            ARGS,
+            PARSED_FILE,
+            COMMON_WORDS,
+            FLAGGED_WORDS,
+            WILL_SHOW_COUNTS,
+            LAYOUT,
+            WILL_SHOW_LINELEN_GRAPH,
+            VOCABULARY);
+
+        // the scene asked for is made first, so this does not wait for the others
+        while (m_layoutWorker.isBusy() && (updateScene(reportMaker) == false))
         {
-            drawLineLengthGraph(ARGS, PARSED_FILE, target, states);
+            m_layoutWorker.waitForScene();
         }
-        else
+
+        updateScene(reportMaker);
+    }
+
+    void ParseDisplayer::requestSetup(
+        const ArgsParser & ARGS,
+        const FileParser & PARSED_FILE,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        const Layout::Enum LAYOUT,
+        const bool WILL_SHOW_LINELEN_GRAPH,
+        const Vocabulary::Enum VOCABULARY)
+    {
+        m_sceneKey.willShowCounts = WILL_SHOW_COUNTS;
+        m_sceneKey.layout = LAYOUT;
+        m_sceneKey.vocabulary = VOCABULARY;
+        m_sceneKey.willShowLineLengthGraph = WILL_SHOW_LINELEN_GRAPH;
+        m_sceneKey.isPreview = false;
+
+        // the scene asked for first, and then every other way to show the same vocabulary, so
+        // that toggling between them only swaps in a scene that is already made, except the
+        // canvas, which is many screens of words and is only made when asked for
+        std::vector<SceneKey> keys;
+        keys.push_back(m_sceneKey);
+
+        for (int layout(0); layout < static_cast<int>(Layout::Canvas); ++layout)
         {
-            for (auto const & TEXT : m_texts)
+            for (auto const WILL_SHOW : { true, false })
             {
-                target.draw(TEXT, states);
+                SceneKey key;
+                key.willShowCounts = WILL_SHOW;
+                key.layout = static_cast<Layout::Enum>(layout);
+                key.vocabulary = VOCABULARY;
+
+                if ((key == m_sceneKey) == false)
+                {
+                    keys.push_back(key);
+                }
             }
         }
+
+        keys.erase(
+            std::remove_if(
+                std::begin(keys),
+                std::end(keys),
+                [&](const SceneKey & KEY) { return (m_sceneCache.count(KEY) > 0); }),
+            std::end(keys));
+
+        m_layoutWorker.request(keys, [&](const SceneKey & KEY) {
+            return makeScene(ARGS, PARSED_FILE, COMMON_WORDS, FLAGGED_WORDS, KEY);
+        });
     }
 
-    void ParseDisplayer::setup(
-        ReportMaker & reportMaker,
+    void ParseDisplayer::requestPreview(
         const ArgsParser & ARGS,
-        const FileParser & PARSED_FILE,
+        const WordCountVec_t & WORDS,
         const WordList & COMMON_WORDS,
         const WordList & FLAGGED_WORDS,
         const bool WILL_SHOW_COUNTS,
-        const bool WILL_SHOW_COLUMS,
-        const bool WILL_SHOW_LINELEN_GRAPH)
+        const Layout::Enum LAYOUT)
+    {
+        m_sceneKey = SceneKey();
+        m_sceneKey.willShowCounts = WILL_SHOW_COUNTS;
+        m_sceneKey.layout = LAYOUT;
+        m_sceneKey.isPreview = true;
+
+        // copied, since the caller moves on to the next snapshot while this one is laid out
+        auto const WORDS_SPTR{ std::make_shared<const WordCountVec_t>(WORDS) };
+
+        m_layoutWorker.request({ m_sceneKey }, [&, WORDS_SPTR](const SceneKey & KEY) {
+            return makeWordScene(ARGS, *WORDS_SPTR, COMMON_WORDS, FLAGGED_WORDS, KEY);
+        });
+    }
+
+    bool ParseDisplayer::updateScene(ReportMaker & reportMaker)
     {
-        m_willShowLineLengthGraph = WILL_SHOW_LINELEN_GRAPH;
+        for (auto & sceneUPtr : m_layoutWorker.takeScenes())
+        {
+            // a preview that finishes after the parse did is already out of date
+            if (sceneUPtr->key().isPreview && (m_sceneKey.isPreview == false))
+            {
+                continue;
+            }
+
+            auto & cachedScene{ m_sceneCache[sceneUPtr->key()] };
+
+            // each preview replaces the last in place, so it must be swapped in again below
+            if (&cachedScene == m_shownScenePtr)
+            {
+                m_shownScenePtr = nullptr;
+            }
 
-        if (m_willShowLineLengthGraph)
+            // the vertexes are only made when the scene is swapped in, since most are never shown
+            cachedScene.sceneUPtr = std::move(sceneUPtr);
+            cachedScene.textBatchUPtr.reset();
+            cachedScene.canvasUPtr.reset();
+        }
+
+        auto const ITER{ m_sceneCache.find(m_sceneKey) };
+
+        if ((ITER == std::end(m_sceneCache)) || (&ITER->second == m_shownScenePtr))
         {
-            return;
+            return false;
         }
 
-        const std::size_t MAX_WORDS_DISPLAY_COUNT{ 500 };
+        auto & cachedScene{ ITER->second };
 
-        m_texts.clear();
-        m_texts.reserve(MAX_WORDS_DISPLAY_COUNT);
+        if (!cachedScene.textBatchUPtr && !cachedScene.canvasUPtr)
+        {
+            auto const TEXT_BATCH_START{ std::chrono::steady_clock::now() };
+            auto const & SCENE{ *cachedScene.sceneUPtr };
 
-        WordCountVec_t wordCounts;
+            if (SCENE.canvasSize().x > 0.0f)
+            {
+                cachedScene.canvasUPtr =
+                    std::make_unique<VirtualCanvas>(m_font, m_glyphMetrics, SCENE);
+            }
+            else
+            {
+                cachedScene.textBatchUPtr = std::make_unique<TextBatch>(m_font, m_glyphMetrics);
+                cachedScene.textBatchUPtr->add(SCENE);
+            }
+
+            cachedScene.textBatchDuration = (std::chrono::steady_clock::now() - TEXT_BATCH_START);
+        }
+
+        m_shownScenePtr = &cachedScene;
+
+        if (m_sceneKey.isPreview == false)
         {
-            auto const PARSED_WORDS{ PARSED_FILE.words() };
+            for (auto iter(std::begin(m_sceneCache)); iter != std::end(m_sceneCache);)
+            {
+                if (iter->first.isPreview)
+                {
+                    iter = m_sceneCache.erase(iter);
+                }
+                else
+                {
+                    ++iter;
+                }
+            }
+        }
+
+        // the line length graph has no words, so the stats of the last layout still stand
+        if (m_shownScenePtr->sceneUPtr->willShowLineLengthGraph() == false)
+        {
+            reportMaker.displayStatsReplace(m_shownScenePtr->sceneUPtr->displayStats());
+
+            reportMaker.displayStatsStream()
+                << "Displayed First Frame Time\t="
+                << std::chrono::duration<double, std::milli>(m_shownScenePtr->textBatchDuration)
+                       .count()
+                << "ms";
 
-            M_LOG_AND_ASSERT_OR_THROW(
-                (PARSED_WORDS.empty() == false),
-                "ParseDisplayer::setupDisplay() the FileParser contained no parsed words.");
+            reportMaker.displayStatsStream()
+                << "Displayed Glyph Atlas\t=" << m_glyphMetrics.pageSizes().size()
+                << " texture pages, " << (m_glyphMetrics.pageByteCount() / 1024) << "KB";
+
+            if (m_shownScenePtr->canvasUPtr)
+            {
+                auto const & CANVAS{ *m_shownScenePtr->canvasUPtr };
+
+                reportMaker.displayStatsStream()
+                    << "Displayed Canvas\t=" << CANVAS.size().x << "x" << CANVAS.size().y
+                    << " in " << CANVAS.columnCount() << "x" << CANVAS.rowCount()
+                    << " tiles of " << CANVAS.tileSize() << "px";
+            }
+        }
 
+        return true;
+    }
+
+    std::unique_ptr<Scene> ParseDisplayer::makeScene(
+        const ArgsParser & ARGS,
+        const FileParser & PARSED_FILE,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const SceneKey & KEY)
+    {
+        if (KEY.willShowLineLengthGraph)
+        {
+            m_layoutSceneUPtr = std::make_unique<Scene>(KEY);
+            setupLineLengthGraph(ARGS, PARSED_FILE);
+            return std::move(m_layoutSceneUPtr);
+        }
+
+        auto const & PARSED_WORDS{ PARSED_FILE.words(KEY.vocabulary) };
+
+        M_LOG_AND_ASSERT_OR_THROW(
+            (PARSED_WORDS.empty() == false),
+            "ParseDisplayer::setupDisplay() the FileParser contained no parsed words.");
+
+        return makeWordScene(ARGS, PARSED_WORDS, COMMON_WORDS, FLAGGED_WORDS, KEY);
+    }
+
+    std::unique_ptr<Scene> ParseDisplayer::makeWordScene(
+        const ArgsParser & ARGS,
+        const WordCountVec_t & PARSED_WORDS,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const SceneKey & KEY)
+    {
+        m_layoutSceneUPtr = std::make_unique<Scene>(KEY);
+
+        // a preview from before anything was counted has nothing to lay out
+        if (PARSED_WORDS.empty())
+        {
+            return std::move(m_layoutSceneUPtr);
+        }
+
+        auto const WILL_SHOW_COUNTS{ KEY.willShowCounts };
+        auto const LAYOUT{ KEY.layout };
+        auto const VOCABULARY{ KEY.vocabulary };
+
+        // the spiral packs by glyph instead of by rect, so it has room for many more words, and
+        // the canvas is not limited to the screen at all
+        std::size_t maxWordsDisplayCount{ 500 };
+
+        if (Layout::Spiral == LAYOUT)
+        {
+            maxWordsDisplayCount = 5000;
+        }
+        else if (Layout::Canvas == LAYOUT)
+        {
+            maxWordsDisplayCount = M_CANVAS_WORD_COUNT_MAX;
+        }
+
+        WordCountVec_t wordCounts;
+        {
             auto iter{ PARSED_WORDS.begin() };
-            auto const ADVANCE_COUNT{ std::min(MAX_WORDS_DISPLAY_COUNT, PARSED_WORDS.size()) };
+            auto const ADVANCE_COUNT{ std::min(maxWordsDisplayCount, PARSED_WORDS.size()) };
             std::advance(iter, static_cast<int>(ADVANCE_COUNT));
             std::copy(PARSED_WORDS.begin(), iter, std::back_inserter(wordCounts));
         }
 
+        auto const LAYOUT_START{ std::chrono::steady_clock::now() };
+
+        // the columns and the canvas are placed by order alone, so they are always quick
+        auto const IS_PLACED_BY_SEARCH{ (Layout::Jumble == LAYOUT) || (Layout::Spiral == LAYOUT) };
+
         std::size_t displayedCount{ 0 };
-        if (WILL_SHOW_COLUMS)
+        if (Layout::Columns == LAYOUT)
         {
             displayedCount =
                 setupAsColumns(ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, wordCounts);
         }
+        else if (Layout::Canvas == LAYOUT)
+        {
+            displayedCount =
+                setupAsCanvas(ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, wordCounts);
+        }
         else
         {
             displayedCount =
-                setupAsJumble(ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, wordCounts);
+                setupFromLastLayout(ARGS, COMMON_WORDS, FLAGGED_WORDS, KEY, wordCounts);
+
+            if (0 == displayedCount)
+            {
+                // whatever the last layout got to place before giving up is thrown away
+                m_layoutSceneUPtr = std::make_unique<Scene>(KEY);
+                m_keptPlacementCount = 0;
+
+                if (Layout::Jumble == LAYOUT)
+                {
+                    displayedCount = setupAsJumble(
+                        ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, wordCounts);
+                }
+                else
+                {
+                    displayedCount = setupAsSpiral(
+                        ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, wordCounts);
+                }
+            }
+
+            recordPlacements(KEY, displayedCount);
         }
 
-        reportMaker.displayStatsStreamClear();
+        auto const LAYOUT_DURATION{ std::chrono::steady_clock::now() - LAYOUT_START };
+
+        // only the window's thread may touch the real ReportMaker, so the stats are kept with
+        // the scene until updateScene() swaps it in
+        ReportMaker reportMaker;
 
         reportMaker.displayStatsStream() << "Displayed " << displayedCount << " words in "
-                                         << ((WILL_SHOW_COLUMS) ? "columns" : "jumble") << " mode"
-                                         << ((WILL_SHOW_COUNTS) ? " with counts showing" : "");
+                                         << boost::algorithm::to_lower_copy(
+                                                Layout::toString(LAYOUT))
+                                         << " mode"
+                                         << ((WILL_SHOW_COUNTS) ? " with counts showing" : "")
+                                         << ((VOCABULARY != Vocabulary::Code)
+                                                 ? (" from " + Vocabulary::toString(VOCABULARY))
+                                                 : "");
+
+        reportMaker.displayStatsStream()
+            << "Displayed Layout Time\t="
+            << std::chrono::duration<double, std::milli>(LAYOUT_DURATION).count() << "ms";
+
+        reportMaker.displayStatsStream() << "Displayed Font Size Max\t=" << m_fontSizeMax
+                                         << " after " << m_layoutPassCount << " layout passes";
+
+        if (IS_PLACED_BY_SEARCH)
+        {
+            if (0 == m_lastPlacementCount)
+            {
+                reportMaker.displayStatsStream()
+                    << "Displayed Layout Reuse\t=none, there was no last layout";
+            }
+            else
+            {
+                reportMaker.displayStatsStream()
+                    << "Displayed Layout Reuse\t=kept " << m_keptPlacementCount << " of "
+                    << m_lastPlacementCount << " words, "
+                    << ((m_changedPlacementCount * 100) / m_lastPlacementCount)
+                    << "% had changed with a max of " << ARGS.layoutChurnMax() << "%";
+            }
+        }
+
+        reportMaker.displayStatsStream() << "Displayed Glyph Metrics Cached\t="
+                                         << m_layoutGlyphMetrics.glyphCount() << " glyphs";
+
+        // measuring the same sizes as drawing costs as many pages again, unless not rasterized
+        if (m_layoutFontFace.isRasterizing())
+        {
+            reportMaker.displayStatsStream()
+                << "Displayed Layout Glyph Atlas\t=" << m_layoutGlyphMetrics.pageSizes().size()
+                << " texture pages, " << (m_layoutGlyphMetrics.pageByteCount() / 1024)
+                << "KB, measured without FreeType";
+        }
+        else
+        {
+            reportMaker.displayStatsStream()
+                << "Displayed Layout Glyph Atlas\t=none, measured with FreeType";
+        }
+
+        std::set<unsigned> pageSizes;
+        for (auto const FONT_SIZE : m_layoutSceneUPtr->fontSizes())
+        {
+            pageSizes.insert(m_layoutGlyphMetrics.pageSize(FONT_SIZE));
+        }
+
+        reportMaker.displayStatsStream()
+            << "Displayed Draw Calls\t=" << pageSizes.size() << " for "
+            << m_layoutSceneUPtr->texts().size() << " texts at "
+            << m_layoutSceneUPtr->fontSizes().size() << " font sizes";
 
         wordCounts.resize(displayedCount);
 
@@ -127,35 +588,351 @@ namespace word_stacker
             wordCounts, "Displayed Frequency List:\t", reportMaker.frequencyListLength()) };
 
         logStatistics(reportMaker, STATS);
+
+        m_layoutSceneUPtr->setDisplayStats(reportMaker.displayStats());
+        return std::move(m_layoutSceneUPtr);
     }
 
-    std::size_t ParseDisplayer::setupAsColumns(
+    template <typename Fits_t, typename Setup_t>
+    std::size_t ParseDisplayer::setupAtLargestFontSize(
+        const ArgsParser & ARGS, const std::string & WORD, Fits_t FITS, Setup_t SETUP)
+    {
+        // a bigger font never fits where a smaller one did not, so the largest size that fits
+        // is found by a binary search of the predicted bounds, without any layout
+        auto findFontSize{ [&](const unsigned FONT_SIZE_LIMIT, const sf::Vector2f & CORRECTION) {
+            auto fits{ [&](const unsigned FONT_SIZE) {
+                auto bounds{ m_layoutGlyphMetrics.predictBounds(WORD, FONT_SIZE) };
+                bounds.left *= CORRECTION.x;
+                bounds.width *= CORRECTION.x;
+                bounds.top *= CORRECTION.y;
+                bounds.height *= CORRECTION.y;
+                return FITS(bounds, FONT_SIZE);
+            } };
+
+            unsigned fontSize{ 0 };
+            unsigned low{ 2 };
+            unsigned high{ FONT_SIZE_LIMIT };
+
+            while (low <= high)
+            {
+                auto const MIDDLE{ low + ((high - low) / 2) };
+
+                if (fits(MIDDLE))
+                {
+                    fontSize = MIDDLE;
+                    low = (MIDDLE + 1);
+                }
+                else
+                {
+                    high = (MIDDLE - 1);
+                }
+            }
+
+            return fontSize;
+        } };
+
+        m_layoutPassCount = 0;
+        m_fontSizeMax = findFontSize(ARGS.fontSizeMax(), sf::Vector2f(1.0f, 1.0f));
+
+        std::size_t displayCount{ 0 };
+
+        if (m_fontSizeMax > 0)
+        {
+            ++m_layoutPassCount;
+            displayCount = SETUP(m_fontSizeMax);
+        }
+
+        if ((0 == displayCount) && (m_fontSizeMax > 2))
+        {
+            // hinting rounds each size its own way, so scale the prediction by how far off it
+            // was at the size that did not fit, and always try at least one size smaller
+            auto const PREDICTED{ m_layoutGlyphMetrics.predictBounds(WORD, m_fontSizeMax) };
+            auto const MEASURED{ m_layoutGlyphMetrics.bounds(WORD, m_fontSizeMax) };
+
+            const sf::Vector2f CORRECTION{
+                ((PREDICTED.width > 0.0f) ? (MEASURED.width / PREDICTED.width) : 1.0f),
+                ((PREDICTED.height > 0.0f) ? (MEASURED.height / PREDICTED.height) : 1.0f)
+            };
+
+            m_fontSizeMax = findFontSize((m_fontSizeMax - 1), CORRECTION);
+
+            if (m_fontSizeMax > 0)
+            {
+                ++m_layoutPassCount;
+                displayCount = SETUP(m_fontSizeMax);
+            }
+        }
+
+        if (0 == displayCount)
+        {
+            std::cerr << "Most frequent word \"" << WORD << "\" will not fit on screen."
+                      << std::endl;
+        }
+
+        return displayCount;
+    }
+
+    template <typename Place_t>
+    std::size_t ParseDisplayer::placeKeptWordsFirst(
+        const std::vector<const sf::Vector2f *> & LAST_POSITION_PTRS,
+        const bool WILL_STOP_AT_FIRST_MISS,
+        WordCountVec_t & wordCounts,
+        Place_t PLACE)
+    {
+        std::vector<bool> isPlaced(wordCounts.size(), false);
+
+        // a kept word that no longer fits where it was, since the count beside it grew, is
+        // placed with the rest
+        for (std::size_t i(0); i < wordCounts.size(); ++i)
+        {
+            if ((LAST_POSITION_PTRS[i] != nullptr) && PLACE(i, LAST_POSITION_PTRS[i]))
+            {
+                isPlaced[i] = true;
+                ++m_keptPlacementCount;
+            }
+        }
+
+        for (std::size_t i(0); i < wordCounts.size(); ++i)
+        {
+            if (isPlaced[i])
+            {
+                continue;
+            }
+
+            if (PLACE(i, nullptr))
+            {
+                isPlaced[i] = true;
+            }
+            else if (0 == i)
+            {
+                // the font size max was found for the last most frequent word, not this one
+                return 0;
+            }
+            else if (WILL_STOP_AT_FIRST_MISS)
+            {
+                break;
+            }
+        }
+
+        WordCountVec_t placedWordCounts;
+
+        for (std::size_t i(0); i < wordCounts.size(); ++i)
+        {
+            if (isPlaced[i])
+            {
+                placedWordCounts.push_back(wordCounts[i]);
+            }
+        }
+
+        wordCounts.swap(placedWordCounts);
+        return wordCounts.size();
+    }
+
+    std::size_t ParseDisplayer::setupFromLastLayout(
         const ArgsParser & ARGS,
         const WordList & COMMON_WORDS,
         const WordList & FLAGGED_WORDS,
-        const bool WILL_SHOW_COUNTS,
+        const SceneKey & KEY,
         WordCountVec_t & wordCounts)
     {
-        unsigned fontSizeMax{ ARGS.fontSizeMax() };
+        m_lastPlacementCount = 0;
+        m_changedPlacementCount = 0;
+        m_keptPlacementCount = 0;
+        m_layoutPlacements.clear();
 
-        auto displayCount{ setupAsColumnsAtFontSize(
-            ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, fontSizeMax, wordCounts) };
+        auto recordKey{ KEY };
+        recordKey.isPreview = false;
 
-        while (0 == displayCount)
+        auto const RECORD_ITER{ m_placementRecords.find(recordKey) };
+
+        if (RECORD_ITER == std::end(m_placementRecords))
         {
-            fontSizeMax /= 2;
-            if (fontSizeMax < 2)
+            return 0;
+        }
+
+        auto const & RECORD{ RECORD_ITER->second };
+
+        // the font sizes are only comparable at the same max, so the max is not searched for
+        m_fontSizeMax = RECORD.fontSizeMax;
+        m_layoutPassCount = 1;
+
+        std::vector<const sf::Vector2f *> lastPositionPtrs(wordCounts.size(), nullptr);
+
+        for (auto const & PLACEMENT : RECORD.placements)
+        {
+            auto const IS_KEPT{ (PLACEMENT.wordsIndex < wordCounts.size()) &&
+                                (wordCounts[PLACEMENT.wordsIndex].word() == PLACEMENT.word) &&
+                                (fontSizeAt(
+                                     ARGS,
+                                     frequencyRatio(wordCounts, PLACEMENT.wordsIndex),
+                                     m_fontSizeMax) == PLACEMENT.fontSize) };
+
+            if (IS_KEPT)
             {
-                std::cerr << "Most frequent word \"" << wordCounts[0].word()
-                          << "\" will not fit on screen." << std::endl;
-                break;
+                lastPositionPtrs[PLACEMENT.wordsIndex] = &PLACEMENT.position;
+            }
+            else
+            {
+                ++m_changedPlacementCount;
             }
+        }
+
+        m_lastPlacementCount = RECORD.placements.size();
+
+        if ((m_changedPlacementCount * 100) > (m_lastPlacementCount * ARGS.layoutChurnMax()))
+        {
+            return 0;
+        }
+
+        auto const WILL_SHOW_COUNTS{ KEY.willShowCounts };
+
+        if (Layout::Jumble == KEY.layout)
+        {
+            SpatialGrid grid(ARGS.screenWidthF(), ARGS.screenHeightF(), M_JUMBLE_GRID_CELL_SIZE);
+
+            // a jumble made from scratch ends at the first word that does not fit, so this does
+            return placeKeptWordsFirst(
+                lastPositionPtrs,
+                true,
+                wordCounts,
+                [&](const std::size_t WORDS_INDEX, const sf::Vector2f * const POSITION_PTR) {
+                    return placeNextJumbledWord(
+                        ARGS,
+                        COMMON_WORDS,
+                        FLAGGED_WORDS,
+                        WILL_SHOW_COUNTS,
+                        grid,
+                        wordCounts,
+                        WORDS_INDEX,
+                        m_fontSizeMax,
+                        POSITION_PTR);
+                });
+        }
+
+        SpiralPacker packer(
+            static_cast<std::size_t>(ARGS.screenWidthF() / M_SPIRAL_CELL_SIZE),
+            static_cast<std::size_t>(ARGS.screenHeightF() / M_SPIRAL_CELL_SIZE),
+            M_SPIRAL_LEVEL_COUNT);
+
+        return placeKeptWordsFirst(
+            lastPositionPtrs,
+            false,
+            wordCounts,
+            [&](const std::size_t WORDS_INDEX, const sf::Vector2f * const POSITION_PTR) {
+                return placeNextSpiralWord(
+                    ARGS,
+                    COMMON_WORDS,
+                    FLAGGED_WORDS,
+                    WILL_SHOW_COUNTS,
+                    packer,
+                    wordCounts,
+                    WORDS_INDEX,
+                    m_fontSizeMax,
+                    POSITION_PTR);
+            });
+    }
+
+    void ParseDisplayer::recordPlacements(const SceneKey & KEY, const std::size_t DISPLAYED_COUNT)
+    {
+        auto recordKey{ KEY };
+        recordKey.isPreview = false;
+
+        if (0 == DISPLAYED_COUNT)
+        {
+            m_placementRecords.erase(recordKey);
+        }
+        else
+        {
+            auto & record{ m_placementRecords[recordKey] };
+            record.fontSizeMax = m_fontSizeMax;
+            record.placements.swap(m_layoutPlacements);
+        }
+
+        m_layoutPlacements.clear();
+    }
+
+    float ParseDisplayer::frequencyRatio(
+        const WordCountVec_t & WORDS, const std::size_t WORDS_INDEX)
+    {
+        auto const FREQ_MIN{ WORDS[WORDS.size() - 1].count() };
+        auto const HIGHEST_WORD_FREQ_F{ static_cast<float>(WORDS[0].count()) };
+        auto const FREQ{ WORDS[WORDS_INDEX].count() };
+
+        return (
+            ((WORDS.size() == 1) || ((WORDS[0].count() - FREQ_MIN) == 0))
+                ? 1.0f
+                : (static_cast<float>(FREQ - FREQ_MIN) /
+                   (HIGHEST_WORD_FREQ_F - static_cast<float>(FREQ_MIN))));
+    }
+
+    unsigned ParseDisplayer::fontSizeAt(
+        const ArgsParser & ARGS, const float FREQ_RATIO, const unsigned FONT_SIZE_MAX)
+    {
+        const unsigned FONT_SIZE_MIN{ std::min(ARGS.fontSizeMin(), (FONT_SIZE_MAX - 1)) };
+
+        return (
+            FONT_SIZE_MIN +
+            static_cast<unsigned>(static_cast<float>(FONT_SIZE_MAX - FONT_SIZE_MIN) * FREQ_RATIO));
+    }
+
+    const sf::Color ParseDisplayer::wordColor(
+        const std::string & WORD,
+        const float FREQ_RATIO,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS) const
+    {
+        if (FLAGGED_WORDS.contains(WORD))
+        {
+            return sf::Color::Red;
+        }
+
+        auto const COMMON_ORDER{ COMMON_WORDS.order(WORD) };
+
+        if (0 == COMMON_ORDER)
+        {
+            return m_uniqueColors.colorAtRatio(FREQ_RATIO);
+        }
+
+        auto const COMMON_WORDS_COUNT_F{ static_cast<float>(COMMON_WORDS.count()) };
+
+        return m_commonColors.colorAtRatio(
+            (COMMON_WORDS_COUNT_F - static_cast<float>(COMMON_ORDER)) / COMMON_WORDS_COUNT_F);
+    }
+
+    std::size_t ParseDisplayer::setupAsColumns(
+        const ArgsParser & ARGS,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        WordCountVec_t & wordCounts)
+    {
+        std::ostringstream ss;
+
+        if (WILL_SHOW_COUNTS)
+        {
+            ss << wordCounts[0].count();
+        }
+
+        auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(ss.str(), 30) };
+        auto const PAD{ 20.0f };
 
-            displayCount = setupAsColumnsAtFontSize(
-                ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, fontSizeMax, wordCounts);
-        }
+        // see setupColumn() for where the first word goes
+        auto const FITS{ [&](const sf::FloatRect & WORD_BOUNDS, const unsigned) {
+            return (
+                ((COUNT_BOUNDS.width + PAD + WORD_BOUNDS.width) <= ARGS.screenWidthF()) &&
+                (((WORD_BOUNDS.height * 1.1f) + PAD) <= ARGS.screenHeightF()));
+        } };
 
-        return displayCount;
+        return setupAtLargestFontSize(
+            ARGS, wordCounts[0].word(), FITS, [&](const unsigned FONT_SIZE_MAX) {
+                return setupAsColumnsAtFontSize(
+                    ARGS,
+                    COMMON_WORDS,
+                    FLAGGED_WORDS,
+                    WILL_SHOW_COUNTS,
+                    FONT_SIZE_MAX,
+                    wordCounts);
+            });
     }
 
     std::size_t ParseDisplayer::setupAsColumnsAtFontSize(
@@ -201,26 +978,41 @@ namespace word_stacker
         const bool WILL_SHOW_COUNTS,
         WordCountVec_t & wordCounts)
     {
-        unsigned fontSizeMax{ ARGS.fontSizeMax() };
-
-        auto displayCount{ setupAsJumbleAtFontSize(
-            ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, fontSizeMax, wordCounts) };
+        std::ostringstream ss;
 
-        while (0 == displayCount)
+        if (WILL_SHOW_COUNTS)
         {
-            fontSizeMax /= 2;
-            if (fontSizeMax < 2)
-            {
-                std::cerr << "Most frequent word \"" << wordCounts[0].word()
-                          << "\" will not fit on screen." << std::endl;
-                break;
-            }
-
-            displayCount = setupAsJumbleAtFontSize(
-                ARGS, COMMON_WORDS, FLAGGED_WORDS, WILL_SHOW_COUNTS, fontSizeMax, wordCounts);
+            ss << wordCounts[0].count();
         }
 
-        return displayCount;
+        auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(ss.str(), 30) };
+        auto const COUNT_TO_WORD_PAD{ 20.0f };
+
+        // see placeNextJumbledWord() and findNextJumblePosition() for the first word
+        auto const FITS{ [&](const sf::FloatRect & WORD_BOUNDS, const unsigned FONT_SIZE) {
+            auto const EXTRA_HEIGHT{ static_cast<float>(FONT_SIZE) / 2.0f };
+
+            auto const WIDTH{ ((WILL_SHOW_COUNTS) ? (COUNT_BOUNDS.width + COUNT_TO_WORD_PAD)
+                                                  : 0.0f) +
+                              WORD_BOUNDS.width + EXTRA_HEIGHT };
+
+            auto const HEIGHT{ std::max(WORD_BOUNDS.height, COUNT_BOUNDS.height) +
+                               (1.5f * EXTRA_HEIGHT) };
+
+            return (
+                (WIDTH < ARGS.screenWidthF()) && (HEIGHT < (ARGS.screenHeightF() - 100.0f)));
+        } };
+
+        return setupAtLargestFontSize(
+            ARGS, wordCounts[0].word(), FITS, [&](const unsigned FONT_SIZE_MAX) {
+                return setupAsJumbleAtFontSize(
+                    ARGS,
+                    COMMON_WORDS,
+                    FLAGGED_WORDS,
+                    WILL_SHOW_COUNTS,
+                    FONT_SIZE_MAX,
+                    wordCounts);
+            });
     }
 
     std::size_t ParseDisplayer::setupAsJumbleAtFontSize(
@@ -231,7 +1023,9 @@ namespace word_stacker
         const unsigned FONT_SIZE_MAX,
         WordCountVec_t & wordCounts)
     {
-        RectVec_t rects;
+        m_layoutPlacements.clear();
+
+        SpatialGrid grid(ARGS.screenWidthF(), ARGS.screenHeightF(), M_JUMBLE_GRID_CELL_SIZE);
         std::size_t wordCountsIndex{ 0 };
         while (wordCountsIndex < wordCounts.size())
         {
@@ -240,7 +1034,7 @@ namespace word_stacker
                     COMMON_WORDS,
                     FLAGGED_WORDS,
                     WILL_SHOW_COUNTS,
-                    rects,
+                    grid,
                     wordCounts,
                     wordCountsIndex,
                     FONT_SIZE_MAX) == false)
@@ -261,55 +1055,23 @@ namespace word_stacker
         const WordList & COMMON_WORDS,
         const WordList & FLAGGED_WORDS,
         const bool WILL_SHOW_COUNTS,
-        RectVec_t & rects,
+        SpatialGrid & grid,
         const WordCountVec_t & WORDS,
         const std::size_t WORDS_INDEX,
-        const unsigned FONT_SIZE_MAX)
+        const unsigned FONT_SIZE_MAX,
+        const sf::Vector2f * const POSITION_PTR)
     {
-        auto const FREQ_MIN{ WORDS[WORDS.size() - 1].count() };
-        auto const HIGHEST_WORD_FREQ_F{ static_cast<float>(WORDS[0].count()) };
         auto const FREQ{ WORDS[WORDS_INDEX].count() };
-
-        auto const FREQ_RATIO{ (
-            ((WORDS.size() == 1) || ((WORDS[0].count() - FREQ_MIN) == 0))
-                ? 1.0f
-                : (static_cast<float>(FREQ - FREQ_MIN) /
-                   static_cast<float>(HIGHEST_WORD_FREQ_F - static_cast<float>(FREQ_MIN)))) };
+        auto const FREQ_RATIO{ frequencyRatio(WORDS, WORDS_INDEX) };
 
         auto const WORD{ WORDS[WORDS_INDEX].word() };
-        auto const COMMON_ORDER{ COMMON_WORDS.order(WORD) };
-        auto const COMMON_WORDS_COUNT_F{ static_cast<float>(COMMON_WORDS.count()) };
-
-        auto const COMMON_RATIO{ (COMMON_WORDS_COUNT_F - static_cast<float>(COMMON_ORDER)) /
-                                 COMMON_WORDS_COUNT_F };
 
         const unsigned FONT_SIZE_COUNT{ 30 };
-        const unsigned FONT_SIZE_MIN{ std::min(ARGS.fontSizeMin(), (FONT_SIZE_MAX - 1)) };
-
-        // make an sf::Text object for the word
-        auto const FONT_SIZE{ FONT_SIZE_MIN +
-                              static_cast<unsigned>(
-                                  static_cast<float>(FONT_SIZE_MAX - FONT_SIZE_MIN) * FREQ_RATIO) };
-
-        sf::Text wordText(WORD, m_font, FONT_SIZE);
-
-        const sf::Vector2f LOCAL_POS{ wordText.getLocalBounds().left,
-                                      wordText.getLocalBounds().top };
-
-        wordText.setOrigin(LOCAL_POS);
+        auto const FONT_SIZE{ fontSizeAt(ARGS, FREQ_RATIO, FONT_SIZE_MAX) };
 
-        wordText.setFillColor(
-            ((COMMON_ORDER == 0) ? m_uniqueColors.colorAtRatio(FREQ_RATIO)
-                                 : m_commonColors.colorAtRatio(COMMON_RATIO)));
+        // measure without making sf::Text objects, since the words are drawn by TextBatch
+        auto const WORD_BOUNDS{ m_layoutGlyphMetrics.bounds(WORD, FONT_SIZE) };
 
-        if (FLAGGED_WORDS.contains(WORD))
-        {
-            wordText.setFillColor(sf::Color::Red);
-        }
-
-        wordText.setPosition(0.0f, 0.0f);
-
-        // make an sf::Text object for the count
         std::ostringstream ss;
 
         if (WILL_SHOW_COUNTS)
@@ -317,33 +1079,31 @@ namespace word_stacker
             ss << FREQ;
         }
 
-        sf::Text countText(ss.str(), m_font, FONT_SIZE_COUNT);
-        countText.setFillColor(sf::Color::White);
+        auto const COUNT_STR{ ss.str() };
+        auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(COUNT_STR, FONT_SIZE_COUNT) };
 
         // extra vertical space to compensate for sfml's inability to know actual font height
         auto const EXTRA_HEIGHT{ static_cast<float>(FONT_SIZE) / 2.0f };
 
+        sf::Vector2f wordPos{ 0.0f, 0.0f };
+        sf::Vector2f countPos{ 0.0f, 0.0f };
+
         // move the word over so it doesn't overlap with the count
         if (WILL_SHOW_COUNTS)
         {
             // center the count text to the left of the wordText
-            auto const COUNT_TEXT_VERT_POS{ ((wordText.getGlobalBounds().height * 0.5f) -
-                                             (countText.getGlobalBounds().height * 0.5f)) +
-                                            EXTRA_HEIGHT };
-
-            countText.setPosition(0.0f, COUNT_TEXT_VERT_POS);
+            countPos.y = (((WORD_BOUNDS.height * 0.5f) - (COUNT_BOUNDS.height * 0.5f)) +
+                          EXTRA_HEIGHT);
 
             auto const COUNT_TO_WORD_PAD{ 20.0f };
-            wordText.move(countText.getGlobalBounds().width + COUNT_TO_WORD_PAD, EXTRA_HEIGHT);
+            wordPos = sf::Vector2f((COUNT_BOUNDS.width + COUNT_TO_WORD_PAD), EXTRA_HEIGHT);
         }
 
-        const sf::Vector2f SIZE{
-            wordText.getGlobalBounds().left + wordText.getGlobalBounds().width + EXTRA_HEIGHT,
-            std::max(wordText.getGlobalBounds().height, countText.getGlobalBounds().height) +
-                (1.5f * EXTRA_HEIGHT)
-        };
+        const sf::Vector2f SIZE{ wordPos.x + WORD_BOUNDS.width + EXTRA_HEIGHT,
+                                 std::max(WORD_BOUNDS.height, COUNT_BOUNDS.height) +
+                                     (1.5f * EXTRA_HEIGHT) };
 
-        auto const POS{ findNextJumblePosition(ARGS, SIZE, rects) };
+        auto const POS{ findNextJumblePosition(ARGS, SIZE, grid, POSITION_PTR) };
 
         if ((POS.x < 0.0f) || (POS.y < 0.0f))
         {
@@ -353,21 +1113,301 @@ namespace word_stacker
         {
             if (WILL_SHOW_COUNTS)
             {
-                countText.move(POS);
-                m_texts.push_back(countText);
+                m_layoutSceneUPtr->addText(
+                    COUNT_STR, FONT_SIZE_COUNT, sf::Color::White, (POS + countPos));
             }
 
-            wordText.move(POS);
-            m_texts.push_back(wordText);
+            auto const COLOR{ wordColor(WORD, FREQ_RATIO, COMMON_WORDS, FLAGGED_WORDS) };
 
-            rects.push_back(sf::FloatRect(POS, SIZE));
+            m_layoutSceneUPtr->addText(
+                WORD,
+                FONT_SIZE,
+                COLOR,
+                ((POS + wordPos) - sf::Vector2f(WORD_BOUNDS.left, WORD_BOUNDS.top)));
+
+            grid.insert(sf::FloatRect(POS, SIZE));
+            m_layoutPlacements.push_back({ WORDS_INDEX, WORD, FONT_SIZE, POS });
             return true;
         }
     }
 
+    std::size_t ParseDisplayer::setupAsSpiral(
+        const ArgsParser & ARGS,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        WordCountVec_t & wordCounts)
+    {
+        std::ostringstream ss;
+
+        if (WILL_SHOW_COUNTS)
+        {
+            ss << wordCounts[0].count();
+        }
+
+        auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(ss.str(), 30) };
+        auto const PAD{ M_SPIRAL_CELL_SIZE };
+        auto const COUNT_TO_WORD_PAD{ 10.0f };
+
+        // see placeNextSpiralWord() for the size of the first sprite
+        auto const FITS{ [&](const sf::FloatRect & WORD_BOUNDS, const unsigned) {
+            auto const WIDTH{ PAD +
+                              ((WILL_SHOW_COUNTS) ? (COUNT_BOUNDS.width + COUNT_TO_WORD_PAD)
+                                                  : 0.0f) +
+                              WORD_BOUNDS.width + PAD };
+
+            auto const HEIGHT{ std::max(WORD_BOUNDS.height, COUNT_BOUNDS.height) + (PAD * 2.0f) };
+
+            return (
+                (std::ceil(WIDTH / M_SPIRAL_CELL_SIZE) <=
+                 std::floor(ARGS.screenWidthF() / M_SPIRAL_CELL_SIZE)) &&
+                (std::ceil(HEIGHT / M_SPIRAL_CELL_SIZE) <=
+                 std::floor(ARGS.screenHeightF() / M_SPIRAL_CELL_SIZE)));
+        } };
+
+        return setupAtLargestFontSize(
+            ARGS, wordCounts[0].word(), FITS, [&](const unsigned FONT_SIZE_MAX) {
+                return setupAsSpiralAtFontSize(
+                    ARGS,
+                    COMMON_WORDS,
+                    FLAGGED_WORDS,
+                    WILL_SHOW_COUNTS,
+                    FONT_SIZE_MAX,
+                    wordCounts);
+            });
+    }
+
+    std::size_t ParseDisplayer::setupAsSpiralAtFontSize(
+        const ArgsParser & ARGS,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        const unsigned FONT_SIZE_MAX,
+        WordCountVec_t & wordCounts)
+    {
+        m_layoutPlacements.clear();
+
+        SpiralPacker packer(
+            static_cast<std::size_t>(ARGS.screenWidthF() / M_SPIRAL_CELL_SIZE),
+            static_cast<std::size_t>(ARGS.screenHeightF() / M_SPIRAL_CELL_SIZE),
+            M_SPIRAL_LEVEL_COUNT);
+
+        WordCountVec_t placedWordCounts;
+
+        for (std::size_t wordCountsIndex(0); wordCountsIndex < wordCounts.size(); ++wordCountsIndex)
+        {
+            auto const WAS_PLACED{ placeNextSpiralWord(
+                ARGS,
+                COMMON_WORDS,
+                FLAGGED_WORDS,
+                WILL_SHOW_COUNTS,
+                packer,
+                wordCounts,
+                wordCountsIndex,
+                FONT_SIZE_MAX) };
+
+            if (WAS_PLACED)
+            {
+                placedWordCounts.push_back(wordCounts[wordCountsIndex]);
+            }
+            else if (0 == wordCountsIndex)
+            {
+                return 0;
+            }
+        }
+
+        wordCounts.swap(placedWordCounts);
+        return wordCounts.size();
+    }
+
+    bool ParseDisplayer::placeNextSpiralWord(
+        const ArgsParser & ARGS,
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        SpiralPacker & packer,
+        const WordCountVec_t & WORDS,
+        const std::size_t WORDS_INDEX,
+        const unsigned FONT_SIZE_MAX,
+        const sf::Vector2f * const POSITION_PTR)
+    {
+        auto const FREQ{ WORDS[WORDS_INDEX].count() };
+        auto const FREQ_RATIO{ frequencyRatio(WORDS, WORDS_INDEX) };
+
+        auto const WORD{ WORDS[WORDS_INDEX].word() };
+
+        const unsigned FONT_SIZE_COUNT{ 30 };
+        auto const FONT_SIZE{ fontSizeAt(ARGS, FREQ_RATIO, FONT_SIZE_MAX) };
+
+        // measure without making sf::Text objects, since the words are drawn by TextBatch
+        auto const WORD_BOUNDS{ m_layoutGlyphMetrics.bounds(WORD, FONT_SIZE) };
+
+        std::ostringstream ss;
+
+        if (WILL_SHOW_COUNTS)
+        {
+            ss << FREQ;
+        }
+
+        auto const COUNT_STR{ ss.str() };
+        auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(COUNT_STR, FONT_SIZE_COUNT) };
+
+        // the sprite is padded by one cell all around, so words never quite touch
+        auto const PAD{ M_SPIRAL_CELL_SIZE };
+        auto const HEIGHT{ std::max(WORD_BOUNDS.height, COUNT_BOUNDS.height) };
+
+        // where the top-left of each text goes in the sprite
+        sf::Vector2f wordPos{ PAD, PAD };
+        const sf::Vector2f COUNT_POS{ PAD, (PAD + ((HEIGHT - COUNT_BOUNDS.height) * 0.5f)) };
+
+        // center the count text to the left of the wordText
+        if (WILL_SHOW_COUNTS)
+        {
+            auto const COUNT_TO_WORD_PAD{ 10.0f };
+
+            wordPos = sf::Vector2f(
+                (PAD + COUNT_BOUNDS.width + COUNT_TO_WORD_PAD),
+                (PAD + ((HEIGHT - WORD_BOUNDS.height) * 0.5f)));
+        }
+
+        const sf::Vector2u SPRITE_SIZE{
+            static_cast<unsigned>(
+                std::ceil((wordPos.x + WORD_BOUNDS.width + PAD) / M_SPIRAL_CELL_SIZE)),
+            static_cast<unsigned>(std::ceil((HEIGHT + (PAD * 2.0f)) / M_SPIRAL_CELL_SIZE))
+        };
+
+        OccupancyBitmap sprite(SPRITE_SIZE.x, SPRITE_SIZE.y);
+
+        addGlyphsToSprite(
+            WORD,
+            FONT_SIZE,
+            (wordPos - sf::Vector2f(WORD_BOUNDS.left, WORD_BOUNDS.top)),
+            sprite);
+
+        if (WILL_SHOW_COUNTS)
+        {
+            addGlyphsToSprite(
+                COUNT_STR,
+                FONT_SIZE_COUNT,
+                (COUNT_POS - sf::Vector2f(COUNT_BOUNDS.left, COUNT_BOUNDS.top)),
+                sprite);
+        }
+
+        auto const CELL_POS{ (nullptr == POSITION_PTR)
+                                 ? packer.place(sprite)
+                                 : packer.placeAt(
+                                       sprite,
+                                       sf::Vector2i(
+                                           static_cast<int>(std::round(
+                                               POSITION_PTR->x / M_SPIRAL_CELL_SIZE)),
+                                           static_cast<int>(std::round(
+                                               POSITION_PTR->y / M_SPIRAL_CELL_SIZE)))) };
+
+        if ((CELL_POS.x < 0) || (CELL_POS.y < 0))
+        {
+            return false;
+        }
+
+        const sf::Vector2f POS{ (static_cast<float>(CELL_POS.x) * M_SPIRAL_CELL_SIZE),
+                                (static_cast<float>(CELL_POS.y) * M_SPIRAL_CELL_SIZE) };
+
+        if (WILL_SHOW_COUNTS)
+        {
+            m_layoutSceneUPtr->addText(
+                COUNT_STR,
+                FONT_SIZE_COUNT,
+                sf::Color::White,
+                ((COUNT_POS + POS) - sf::Vector2f(COUNT_BOUNDS.left, COUNT_BOUNDS.top)));
+        }
+
+        auto const COLOR{ wordColor(WORD, FREQ_RATIO, COMMON_WORDS, FLAGGED_WORDS) };
+
+        m_layoutSceneUPtr->addText(
+            WORD,
+            FONT_SIZE,
+            COLOR,
+            ((wordPos + POS) - sf::Vector2f(WORD_BOUNDS.left, WORD_BOUNDS.top)));
+
+        m_layoutPlacements.push_back({ WORDS_INDEX, WORD, FONT_SIZE, POS });
+        return true;
+    }
+
+    void ParseDisplayer::addGlyphsToSprite(
+        const sf::String & STRING,
+        const unsigned FONT_SIZE,
+        const sf::Vector2f & OFFSET,
+        OccupancyBitmap & sprite) const
+    {
+        auto const PAD{ M_SPIRAL_CELL_SIZE };
+
+        // sfml puts the baseline of the first line one character size down, and then moves
+        // along by each advance plus kerning, see sf::Text::ensureGeometryUpdate()
+        auto const BASELINE{ static_cast<float>(FONT_SIZE) };
+        auto horizPos{ 0.0f };
+        sf::Uint32 prevChar{ 0 };
+        sf::FloatRect prevRect;
+
+        auto fillCells{ [&](const float LEFT,
+                            const float TOP,
+                            const float RIGHT,
+                            const float BOTTOM) {
+            sprite.fill(
+                static_cast<long>(std::floor(LEFT / M_SPIRAL_CELL_SIZE)),
+                static_cast<long>(std::floor(TOP / M_SPIRAL_CELL_SIZE)),
+                static_cast<long>(std::ceil(RIGHT / M_SPIRAL_CELL_SIZE)),
+                static_cast<long>(std::ceil(BOTTOM / M_SPIRAL_CELL_SIZE)));
+        } };
+
+        for (std::size_t i(0); i < STRING.getSize(); ++i)
+        {
+            auto const CHAR{ STRING[i] };
+            horizPos += m_layoutGlyphMetrics.kerning(prevChar, CHAR, FONT_SIZE);
+            prevChar = CHAR;
+
+            auto const & GLYPH{ m_layoutGlyphMetrics.glyph(CHAR, FONT_SIZE) };
+
+            const sf::FloatRect RECT{ (OFFSET.x + horizPos + GLYPH.bounds.left - PAD),
+                                      (OFFSET.y + BASELINE + GLYPH.bounds.top - PAD),
+                                      (GLYPH.bounds.width + (PAD * 2.0f)),
+                                      (GLYPH.bounds.height + (PAD * 2.0f)) };
+
+            fillCells(RECT.left, RECT.top, (RECT.left + RECT.width), (RECT.top + RECT.height));
+
+            // also cover the gap to the glyph before where they are side by side, so nothing
+            // gets put between the letters of a word, only above and below them
+            if (i > 0)
+            {
+                fillCells(
+                    (prevRect.left + prevRect.width),
+                    std::max(prevRect.top, RECT.top),
+                    RECT.left,
+                    std::min((prevRect.top + prevRect.height), (RECT.top + RECT.height)));
+            }
+
+            prevRect = RECT;
+            horizPos += GLYPH.advance;
+        }
+    }
+
     const sf::Vector2f ParseDisplayer::findNextJumblePosition(
-        const ArgsParser & ARGS, const sf::Vector2f & SIZE, const RectVec_t & INVALID_RECTS) const
+        const ArgsParser & ARGS,
+        const sf::Vector2f & SIZE,
+        const SpatialGrid & GRID,
+        const sf::Vector2f * const POSITION_PTR) const
     {
+        if (POSITION_PTR != nullptr)
+        {
+            auto const & POS{ *POSITION_PTR };
+
+            auto const IS_VALID{
+                (POS.x >= 0.0f) && (POS.y >= 0.0f) && ((POS.x + SIZE.x) < ARGS.screenWidthF()) &&
+                ((POS.y + SIZE.y) < (ARGS.screenHeightF() - 100.0f)) &&
+                (findNextLowestValidPosition(sf::FloatRect(POS, SIZE), GRID) < 1.0f)
+            };
+
+            return ((IS_VALID) ? POS : sf::Vector2f(-1.0f, -1.0f));
+        }
+
         auto const INTERVAL{ 20.0f };
 
         auto posLeft{ 0.0f };
@@ -377,7 +1417,7 @@ namespace word_stacker
             while ((posTop + SIZE.y) < (ARGS.screenHeightF() - 100.0f))
             {
                 auto const SLIDE_DOWN_AMOUNT{ findNextLowestValidPosition(
-                    sf::FloatRect(posLeft, posTop, SIZE.x, SIZE.y), INVALID_RECTS) };
+                    sf::FloatRect(posLeft, posTop, SIZE.x, SIZE.y), GRID) };
 
                 if (SLIDE_DOWN_AMOUNT < 1.0f)
                 {
@@ -395,28 +1435,20 @@ namespace word_stacker
     }
 
     float ParseDisplayer::findNextLowestValidPosition(
-        const sf::FloatRect & TEST_RECT, const RectVec_t & INVALID_RECTS) const
+        const sf::FloatRect & TEST_RECT, const SpatialGrid & GRID) const
     {
         auto const PAD{ 20.0f };
 
-        auto const TEST_RECT_RIGHT{ TEST_RECT.left + TEST_RECT.width };
-        auto const TEST_RECT_BOTTOM{ TEST_RECT.top + TEST_RECT.height };
+        auto const OVERLAPPING_BOTTOM{ GRID.overlappingBottom(TEST_RECT) };
 
-        for (auto const & INVALID_RECT : INVALID_RECTS)
+        if (OVERLAPPING_BOTTOM <= TEST_RECT.top)
         {
-            auto const INVALID_RECT_BOTTOM{ INVALID_RECT.top + INVALID_RECT.height };
-            auto const INVALID_RECT_RIGHT{ INVALID_RECT.left + INVALID_RECT.width };
-
-            if ((std::max(TEST_RECT.left, INVALID_RECT.left) <
-                 std::min(TEST_RECT_RIGHT, INVALID_RECT_RIGHT)) &&
-                std::max(TEST_RECT.top, INVALID_RECT.top) <
-                    std::min(TEST_RECT_BOTTOM, INVALID_RECT_BOTTOM))
-            {
-                return PAD;
-            }
+            return 0.0f;
         }
 
-        return 0.0f;
+        // every step of PAD until past the lowest overlapping rect would still overlap it, so
+        // they are all taken at once, which lands exactly where stepping one at a time would
+        return (PAD * std::ceil((OVERLAPPING_BOTTOM - TEST_RECT.top) / PAD));
     }
 
     void ParseDisplayer::loadFont(const ArgsParser & ARGS)
@@ -440,6 +1472,13 @@ namespace word_stacker
             (m_font.loadFromFile(PATH_STR.c_str())),
             "During ParseDisplayer::LoadFont() sf::Font::loadFromFile(\""
                 << PATH_STR << "\") failed!  Check console output for information.");
+
+        // neither sfml nor freetype can share a font between threads, so the layout thread
+        // gets its own
+        M_LOG_AND_ASSERT_OR_THROW(
+            (m_layoutFontFace.loadFromFile(PATH_STR)),
+            "During ParseDisplayer::LoadFont() FontFace::loadFromFile(\""
+                << PATH_STR << "\") failed for the layout font!");
     }
 
     void ParseDisplayer::setupColumn(
@@ -453,14 +1492,10 @@ namespace word_stacker
         const unsigned FONT_SIZE_MAX)
     {
         const unsigned FONT_SIZE_COUNT{ 30 };
-        const unsigned FONT_SIZE_MIN{ std::min(ARGS.fontSizeMin(), (FONT_SIZE_MAX - 1)) };
 
         auto const WIDTH{ ARGS.screenWidthF() };
         auto const HEIGHT{ ARGS.screenHeightF() };
         auto const PAD{ 20.0f };
-        auto const FREQ_MIN{ WORDS[WORDS.size() - 1].count() };
-        auto const COMMON_WORDS_COUNT_F{ static_cast<float>(COMMON_WORDS.count()) };
-        auto const HIGHEST_WORD_FREQ_F{ static_cast<float>(WORDS[0].count()) };
 
         auto maxHorizExtent{ 0.0f };
         auto vertPos{ 0.0f };
@@ -468,45 +1503,14 @@ namespace word_stacker
         while (wordsIndex < WORDS.size())
         {
             auto const FREQ{ WORDS[wordsIndex].count() };
-
-            auto const FREQ_RATIO{ (
-                ((WORDS.size() == 1) || ((WORDS[0].count() - FREQ_MIN) == 0))
-                    ? 1.0f
-                    : (static_cast<float>(FREQ - FREQ_MIN) /
-                       static_cast<float>(HIGHEST_WORD_FREQ_F - static_cast<float>(FREQ_MIN)))) };
+            auto const FREQ_RATIO{ frequencyRatio(WORDS, wordsIndex) };
 
             auto const WORD{ WORDS[wordsIndex].word() };
+            auto const FONT_SIZE{ fontSizeAt(ARGS, FREQ_RATIO, FONT_SIZE_MAX) };
 
-            auto const COMMON_ORDER{ COMMON_WORDS.order(WORD) };
-
-            auto const COMMON_RATIO{ (COMMON_WORDS_COUNT_F - static_cast<float>(COMMON_ORDER)) /
-                                     COMMON_WORDS_COUNT_F };
-
-            // make an sf::Text object for the word
-            auto const FONT_SIZE{
-                FONT_SIZE_MIN + static_cast<unsigned>(
-                                    static_cast<float>(FONT_SIZE_MAX - FONT_SIZE_MIN) * FREQ_RATIO)
-            };
-
-            sf::Text wordText(WORD, m_font, FONT_SIZE);
-
-            const sf::Vector2f LOCAL_POS{ wordText.getLocalBounds().left,
-                                          wordText.getLocalBounds().top };
-
-            wordText.setOrigin(LOCAL_POS);
-
-            wordText.setFillColor(
-                ((COMMON_ORDER == 0) ? m_uniqueColors.colorAtRatio(FREQ_RATIO)
-                                     : m_commonColors.colorAtRatio(COMMON_RATIO)));
-
-            if (FLAGGED_WORDS.contains(WORD))
-            {
-                wordText.setFillColor(sf::Color::Red);
-            }
-
-            wordText.setPosition(posLeft, vertPos);
+            // measure without making sf::Text objects, since the words are drawn by TextBatch
+            auto const WORD_BOUNDS{ m_layoutGlyphMetrics.bounds(WORD, FONT_SIZE) };
 
-            // make an sf::Text object for the count
             std::ostringstream ss;
 
             if (WILL_SHOW_COUNTS)
@@ -514,22 +1518,14 @@ namespace word_stacker
                 ss << FREQ;
             }
 
-            sf::Text countText(ss.str(), m_font, FONT_SIZE_COUNT);
-
-            const sf::Vector2f COUNT_LOCAL_POS{ countText.getLocalBounds().left,
-                                                countText.getLocalBounds().top };
-
-            countText.setOrigin(COUNT_LOCAL_POS);
-
-            countText.setFillColor(sf::Color::White);
-
-            countText.setPosition(posLeft, vertPos);
+            auto const COUNT_STR{ ss.str() };
+            auto const COUNT_BOUNDS{ m_layoutGlyphMetrics.bounds(COUNT_STR, FONT_SIZE_COUNT) };
 
             // move the word over so it doesn't overlap with the count
-            wordText.move(countText.getGlobalBounds().width + PAD, 0.0f);
+            const sf::Vector2f COUNT_POS{ posLeft, vertPos };
+            const sf::Vector2f WORD_POS{ (posLeft + (COUNT_BOUNDS.width + PAD)), vertPos };
 
-            auto const HORIZ_EXTENT{ wordText.getGlobalBounds().left +
-                                     wordText.getGlobalBounds().width };
+            auto const HORIZ_EXTENT{ WORD_POS.x + WORD_BOUNDS.width };
 
             if (maxHorizExtent < HORIZ_EXTENT)
             {
@@ -542,8 +1538,7 @@ namespace word_stacker
             }
 
             vertPos =
-                (wordText.getGlobalBounds().top + wordText.getGlobalBounds().height +
-                 (wordText.getGlobalBounds().height * 0.1f) + PAD);
+                (WORD_POS.y + WORD_BOUNDS.height + (WORD_BOUNDS.height * 0.1f) + PAD);
 
             if (vertPos > HEIGHT)
             {
@@ -552,10 +1547,20 @@ namespace word_stacker
 
             if (WILL_SHOW_COUNTS)
             {
-                m_texts.push_back(countText);
+                m_layoutSceneUPtr->addText(
+                    COUNT_STR,
+                    FONT_SIZE_COUNT,
+                    sf::Color::White,
+                    (COUNT_POS - sf::Vector2f(COUNT_BOUNDS.left, COUNT_BOUNDS.top)));
             }
 
-            m_texts.push_back(wordText);
+            auto const COLOR{ wordColor(WORD, FREQ_RATIO, COMMON_WORDS, FLAGGED_WORDS) };
+
+            m_layoutSceneUPtr->addText(
+                WORD,
+                FONT_SIZE,
+                COLOR,
+                (WORD_POS - sf::Vector2f(WORD_BOUNDS.left, WORD_BOUNDS.top)));
 
             ++wordsIndex;
         }
@@ -582,61 +1587,152 @@ namespace word_stacker
         }
     }
 
-    void ParseDisplayer::drawLineLengthGraph(
+    std::size_t ParseDisplayer::setupAsCanvas(
         const ArgsParser & ARGS,
-        const FileParser & PARSED_FILE,
-        sf::RenderTarget & target,
-        sf::RenderStates states) const
+        const WordList & COMMON_WORDS,
+        const WordList & FLAGGED_WORDS,
+        const bool WILL_SHOW_COUNTS,
+        const WordCountVec_t & WORDS)
     {
-        auto const & LINELEN_MAP{ PARSED_FILE.lengthCountMap() };
+        const unsigned FONT_SIZE_COUNT_MAX{ 30 };
+        auto const FONT_SIZE_MAX{ ARGS.fontSizeMax() };
+
+        // with tens of thousands of words almost all have the lowest counts, so the font size
+        // follows the log of the count or all but the first few would be the smallest size
+        auto const LOG_FREQ_MIN{ std::log(static_cast<float>(WORDS.back().count())) };
 
-        if (LINELEN_MAP.size() < 2)
+        auto const LOG_FREQ_RANGE{ std::log(static_cast<float>(WORDS.front().count())) -
+                                   LOG_FREQ_MIN };
+
+        // Responsible for wrapping what the first pass works out about a word for the second.
+        struct MeasuredWord
         {
-            return;
-        }
+            float freqRatio{ 0.0f };
+            unsigned fontSize{ 0 };
+            unsigned fontSizeCount{ 0 };
+            std::string countStr{};
+            sf::FloatRect wordBounds{};
+            sf::FloatRect countBounds{};
+            float gap{ 0.0f };
+            float countWidth{ 0.0f };
+            sf::Vector2f size{ 0.0f, 0.0f };
+        };
+
+        std::vector<MeasuredWord> measuredWords;
+        measuredWords.reserve(WORDS.size());
+
+        auto wordArea{ 0.0f };
+        auto wordWidthMax{ 0.0f };
 
-        // determine line length min/max and line length count min/max/sum
-        std::size_t lineLengthMin{ LINELEN_MAP.begin()->first };
-        std::size_t lineLengthMax{ lineLengthMin };
-        std::size_t lineCountSum{ 0 };
-        std::size_t lineCountMin{ LINELEN_MAP.begin()->second };
-        std::size_t lineCountMax{ lineCountMin };
-        for (auto const & LENGTH_COUNT_PAIR : LINELEN_MAP)
+        for (auto const & WORD_COUNT : WORDS)
         {
-            lineCountSum += LENGTH_COUNT_PAIR.second;
+            MeasuredWord measured;
 
-            if (LENGTH_COUNT_PAIR.first < lineLengthMin)
-            {
-                lineLengthMin = LENGTH_COUNT_PAIR.first;
-            }
+            measured.freqRatio =
+                ((LOG_FREQ_RANGE > 0.0f)
+                     ? ((std::log(static_cast<float>(WORD_COUNT.count())) - LOG_FREQ_MIN) /
+                        LOG_FREQ_RANGE)
+                     : 1.0f);
+
+            measured.fontSize = fontSizeAt(ARGS, measured.freqRatio, FONT_SIZE_MAX);
+
+            measured.wordBounds =
+                m_layoutGlyphMetrics.bounds(WORD_COUNT.word(), measured.fontSize);
 
-            if (LENGTH_COUNT_PAIR.first > lineLengthMax)
+            if (WILL_SHOW_COUNTS)
             {
-                lineLengthMax = LENGTH_COUNT_PAIR.first;
+                measured.countStr = std::to_string(WORD_COUNT.count());
             }
 
-            if (LENGTH_COUNT_PAIR.second < lineCountMin)
+            measured.fontSizeCount = std::min(measured.fontSize, FONT_SIZE_COUNT_MAX);
+
+            measured.countBounds =
+                m_layoutGlyphMetrics.bounds(measured.countStr, measured.fontSizeCount);
+
+            measured.gap = static_cast<float>(measured.fontSize) * 0.25f;
+
+            measured.countWidth =
+                ((WILL_SHOW_COUNTS) ? (measured.countBounds.width + measured.gap) : 0.0f);
+
+            measured.size = sf::Vector2f(
+                (measured.countWidth + measured.wordBounds.width),
+                std::max(measured.wordBounds.height, measured.countBounds.height));
+
+            wordArea += ((measured.size.x + measured.gap) * (measured.size.y + measured.gap));
+            wordWidthMax = std::max(wordWidthMax, measured.size.x);
+
+            measuredWords.push_back(measured);
+        }
+
+        // shaped like the screen, so zoomed all the way out the whole canvas fills it, and so
+        // the tiles it is cut into stay square and small instead of long and thin
+        auto const CANVAS_WIDTH{ std::max(
+            wordWidthMax, std::sqrt(wordArea * (ARGS.screenWidthF() / ARGS.screenHeightF()))) };
+
+        sf::Vector2f pos{ 0.0f, 0.0f };
+        auto rowHeight{ 0.0f };
+        auto canvasRight{ 0.0f };
+
+        for (std::size_t i(0); i < WORDS.size(); ++i)
+        {
+            auto const & MEASURED{ measuredWords[i] };
+            auto const WORD{ WORDS[i].word() };
+            auto const & SIZE{ MEASURED.size };
+
+            // left to right in rows, most frequent first, so the rows get shorter going down
+            if ((pos.x > 0.0f) && ((pos.x + SIZE.x) > CANVAS_WIDTH))
             {
-                lineCountMin = LENGTH_COUNT_PAIR.second;
+                pos.x = 0.0f;
+                pos.y += rowHeight;
+                rowHeight = 0.0f;
             }
 
-            if (LENGTH_COUNT_PAIR.second > lineCountMax)
+            if (WILL_SHOW_COUNTS)
             {
-                lineCountMax = LENGTH_COUNT_PAIR.second;
+                m_layoutSceneUPtr->addText(
+                    MEASURED.countStr,
+                    MEASURED.fontSizeCount,
+                    sf::Color::White,
+                    (pos + sf::Vector2f(0.0f, ((SIZE.y - MEASURED.countBounds.height) * 0.5f))) -
+                        sf::Vector2f(MEASURED.countBounds.left, MEASURED.countBounds.top));
             }
+
+            auto const COLOR{ wordColor(WORD, MEASURED.freqRatio, COMMON_WORDS, FLAGGED_WORDS) };
+
+            m_layoutSceneUPtr->addText(
+                WORD,
+                MEASURED.fontSize,
+                COLOR,
+                (pos +
+                 sf::Vector2f(
+                     MEASURED.countWidth, ((SIZE.y - MEASURED.wordBounds.height) * 0.5f))) -
+                    sf::Vector2f(MEASURED.wordBounds.left, MEASURED.wordBounds.top));
+
+            canvasRight = std::max(canvasRight, (pos.x + SIZE.x));
+            pos.x += (SIZE.x + MEASURED.gap);
+            rowHeight = std::max(rowHeight, (SIZE.y + MEASURED.gap));
         }
 
-        std::ostringstream lineLengthMaxSS;
-        lineLengthMaxSS << lineLengthMax;
+        m_layoutSceneUPtr->setCanvasSize(sf::Vector2f(canvasRight, (pos.y + rowHeight)));
+
+        // no search for the largest size that fits, since the canvas is as big as it needs
+        m_fontSizeMax = FONT_SIZE_MAX;
+        m_layoutPassCount = 1;
+        return WORDS.size();
+    }
 
-        std::ostringstream lineLengthMinSS;
-        lineLengthMinSS << lineLengthMin;
+    void ParseDisplayer::setupLineLengthGraph(
+        const ArgsParser & ARGS, const FileParser & PARSED_FILE)
+    {
+        // worked out once after parsing, so nothing here walks the histogram but the bars
+        auto const & SUMMARY{ PARSED_FILE.lineMetricsSummary() };
 
-        std::ostringstream lineCountMaxSS;
-        lineCountMaxSS << lineCountMax;
+        if (SUMMARY.distinctLengthCount < 2)
+        {
+            return;
+        }
 
-        std::ostringstream lineCountMinSS;
-        lineCountMinSS << lineCountMin;
+        auto & scene{ *m_layoutSceneUPtr };
 
         auto const SPACER_RATIO{ 0.1f };
 
@@ -647,143 +1743,203 @@ namespace word_stacker
         auto const GRAPH_WIDTH{ ARGS.screenWidthF() - (HORIZONTAL_SPACER * 2.0f) };
 
         const unsigned LABEL_FONT_SIZE{ 30 };
+        auto const LABEL_COLOR{ m_uniqueColors.colorAtRatio(1.0f) };
+
+        // the labels are placed by the bounds an sf::Text of them would have
+        auto const LABEL_SIZE{ [&](const std::string & STRING) {
+            auto const BOUNDS{ m_layoutGlyphMetrics.bounds(STRING, LABEL_FONT_SIZE) };
+            return sf::Vector2f(BOUNDS.width, BOUNDS.height);
+        } };
 
         // top label
-        sf::Text topLabelText(lineCountMaxSS.str(), m_font, LABEL_FONT_SIZE);
-        topLabelText.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-        topLabelText.setPosition(
-            HORIZONTAL_SPACER, VERTICAL_SPACER - topLabelText.getGlobalBounds().height);
+        auto const TOP_LABEL{ std::to_string(SUMMARY.countMax) };
+        auto const TOP_LABEL_SIZE{ LABEL_SIZE(TOP_LABEL) };
 
-        target.draw(topLabelText, states);
+        scene.addText(
+            TOP_LABEL,
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(HORIZONTAL_SPACER, VERTICAL_SPACER - TOP_LABEL_SIZE.y));
 
         auto const PAD{ 10.0f };
 
-        auto const GRAPH_LEFT{ HORIZONTAL_SPACER + topLabelText.getGlobalBounds().width + PAD };
+        auto const GRAPH_LEFT{ HORIZONTAL_SPACER + TOP_LABEL_SIZE.x + PAD };
         auto const GRAPH_TOP{ VERTICAL_SPACER };
         auto const GRAPH_BOTTOM{ GRAPH_TOP + GRAPH_HEIGHT };
         auto const GRAPH_RIGHT{ GRAPH_LEFT + GRAPH_WIDTH };
 
         // bottom label
-        sf::Text bottomLabelText(lineCountMinSS.str(), m_font, LABEL_FONT_SIZE);
-        bottomLabelText.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-        bottomLabelText.setPosition(
-            (GRAPH_LEFT - bottomLabelText.getGlobalBounds().width) - PAD,
-            (GRAPH_BOTTOM - bottomLabelText.getGlobalBounds().height) - (PAD * 2.0f));
+        auto const BOTTOM_LABEL{ std::to_string(SUMMARY.countMin) };
+        auto const BOTTOM_LABEL_SIZE{ LABEL_SIZE(BOTTOM_LABEL) };
 
-        target.draw(bottomLabelText, states);
+        scene.addText(
+            BOTTOM_LABEL,
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(
+                (GRAPH_LEFT - BOTTOM_LABEL_SIZE.x) - PAD,
+                (GRAPH_BOTTOM - BOTTOM_LABEL_SIZE.y) - (PAD * 2.0f)));
 
         // left label
-        sf::Text leftLabelText(lineLengthMinSS.str(), m_font, LABEL_FONT_SIZE);
-        leftLabelText.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-        leftLabelText.setPosition(GRAPH_LEFT, GRAPH_BOTTOM);
-        target.draw(leftLabelText, states);
+        scene.addText(
+            std::to_string(SUMMARY.lengthMin),
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(GRAPH_LEFT, GRAPH_BOTTOM));
 
         // label for column 80
-        sf::Text label80Text("80", m_font, LABEL_FONT_SIZE);
-        label80Text.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-
         auto const GRAPH_DISTANCE_TO_80{
-            (80.0f / static_cast<float>(lineLengthMax - lineLengthMin)) * GRAPH_WIDTH
+            (80.0f / static_cast<float>(SUMMARY.lengthMax - SUMMARY.lengthMin)) * GRAPH_WIDTH
         };
 
-        label80Text.setPosition(
-            ((GRAPH_LEFT + GRAPH_DISTANCE_TO_80) - label80Text.getGlobalBounds().width) + PAD,
-            GRAPH_BOTTOM);
-
-        target.draw(label80Text, states);
+        scene.addText(
+            "80",
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(
+                ((GRAPH_LEFT + GRAPH_DISTANCE_TO_80) - LABEL_SIZE("80").x) + PAD, GRAPH_BOTTOM));
 
         // label for column 100
-        sf::Text label100Text("100", m_font, LABEL_FONT_SIZE);
-        label100Text.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-
         auto const GRAPH_DISTANCE_TO_100{
-            (100.0f / static_cast<float>(lineLengthMax - lineLengthMin)) * GRAPH_WIDTH
+            (100.0f / static_cast<float>(SUMMARY.lengthMax - SUMMARY.lengthMin)) * GRAPH_WIDTH
         };
 
-        label100Text.setPosition(
-            ((GRAPH_LEFT + GRAPH_DISTANCE_TO_100) - label100Text.getGlobalBounds().width) + PAD,
-            GRAPH_BOTTOM);
-
-        target.draw(label100Text, states);
+        scene.addText(
+            "100",
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(
+                ((GRAPH_LEFT + GRAPH_DISTANCE_TO_100) - LABEL_SIZE("100").x) + PAD,
+                GRAPH_BOTTOM));
 
         // right label
-        sf::Text rightLabelText(lineLengthMaxSS.str(), m_font, LABEL_FONT_SIZE);
-        rightLabelText.setFillColor(m_uniqueColors.colorAtRatio(1.0f));
-        rightLabelText.setPosition(
-            GRAPH_RIGHT - rightLabelText.getGlobalBounds().width, GRAPH_BOTTOM);
+        auto const RIGHT_LABEL{ std::to_string(SUMMARY.lengthMax) };
 
-        target.draw(rightLabelText, states);
+        scene.addText(
+            RIGHT_LABEL,
+            LABEL_FONT_SIZE,
+            LABEL_COLOR,
+            sf::Vector2f(GRAPH_RIGHT - LABEL_SIZE(RIGHT_LABEL).x, GRAPH_BOTTOM));
 
         // esatblish graph bar widths
         auto const BETWEEN_RECT_PAD_RATIO{ 0.1f };
 
-        auto const RAW_RECT_WIDTH{ (GRAPH_WIDTH / static_cast<float>(LINELEN_MAP.size())) *
+        auto const RAW_RECT_WIDTH{ (GRAPH_WIDTH / static_cast<float>(SUMMARY.distinctLengthCount)) *
                                    (1.0f - BETWEEN_RECT_PAD_RATIO) };
 
         auto const RECT_WIDTH{ ((RAW_RECT_WIDTH < 1.0f) ? 1.0f : RAW_RECT_WIDTH) };
 
         // garph limits lines
-        std::vector<sf::Vertex> lineVerts;
-        lineVerts.push_back(
-            sf::Vertex(sf::Vector2f(GRAPH_LEFT, GRAPH_TOP), m_uniqueColors.colorAtRatio(1.0f)));
-
-        lineVerts.push_back(
+        scene.addLine(
+            sf::Vertex(sf::Vector2f(GRAPH_LEFT, GRAPH_TOP), m_uniqueColors.colorAtRatio(1.0f)),
             sf::Vertex(sf::Vector2f(GRAPH_LEFT, GRAPH_BOTTOM), m_uniqueColors.colorAtRatio(0.5f)));
 
-        lineVerts.push_back(
-            sf::Vertex(sf::Vector2f(GRAPH_LEFT, GRAPH_BOTTOM), m_uniqueColors.colorAtRatio(1.0f)));
+        scene.addLine(
+            sf::Vertex(sf::Vector2f(GRAPH_LEFT, GRAPH_BOTTOM), m_uniqueColors.colorAtRatio(1.0f)),
+            sf::Vertex(
+                sf::Vector2f(GRAPH_RIGHT + RECT_WIDTH, GRAPH_BOTTOM),
+                m_uniqueColors.colorAtRatio(1.0f)));
+
+        scene.addLine(
+            sf::Vertex(
+                sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_80, GRAPH_BOTTOM),
+                m_uniqueColors.colorAtRatio(1.0f)),
+            sf::Vertex(
+                sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_80, GRAPH_BOTTOM + PAD),
+                m_uniqueColors.colorAtRatio(1.0f)));
+
+        scene.addLine(
+            sf::Vertex(
+                sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_100, GRAPH_BOTTOM),
+                m_uniqueColors.colorAtRatio(1.0f)),
+            sf::Vertex(
+                sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_100, GRAPH_BOTTOM + PAD),
+                m_uniqueColors.colorAtRatio(1.0f)));
+
+        // where the top middle of the bar for LENGTH lines that COUNT times would be
+        auto const BAR_TOP{ [&](const std::size_t LENGTH, const std::size_t COUNT) {
+            auto const LINE_LENGTH_RATIO{ static_cast<float>(LENGTH) /
+                                          static_cast<float>(SUMMARY.lengthMax) };
+
+            auto const LINE_COUNT_RATIO{ static_cast<float>(COUNT) /
+                                         static_cast<float>(SUMMARY.countMax) };
+
+            return sf::Vector2f(
+                (GRAPH_LEFT + (GRAPH_WIDTH * LINE_LENGTH_RATIO)) + (RECT_WIDTH * 0.5f),
+                ((GRAPH_BOTTOM - 1.0f) - (GRAPH_HEIGHT * LINE_COUNT_RATIO)) - 1.0f);
+        } };
 
-        lineVerts.push_back(sf::Vertex(
-            sf::Vector2f(GRAPH_RIGHT + RECT_WIDTH, GRAPH_BOTTOM),
-            m_uniqueColors.colorAtRatio(1.0f)));
+        // graph rects
+        PARSED_FILE.lineMetrics().forEach([&](const std::size_t LENGTH, const std::size_t COUNT) {
+            auto const TOP_MIDDLE{ BAR_TOP(LENGTH, COUNT) };
 
-        lineVerts.push_back(sf::Vertex(
-            sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_80, GRAPH_BOTTOM),
-            m_uniqueColors.colorAtRatio(1.0f)));
+            auto const LEFT{ TOP_MIDDLE.x - (RECT_WIDTH * 0.5f) };
+            auto const RIGHT{ (LEFT + RECT_WIDTH) };
+            auto const BOTTOM{ GRAPH_BOTTOM - 1.0f };
+            auto const TOP{ TOP_MIDDLE.y };
 
-        lineVerts.push_back(sf::Vertex(
-            sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_80, GRAPH_BOTTOM + PAD),
-            m_uniqueColors.colorAtRatio(1.0f)));
+            auto const COLOR_TOP_RATIO{ static_cast<float>(COUNT) /
+                                        static_cast<float>(SUMMARY.countMax) };
 
-        lineVerts.push_back(sf::Vertex(
-            sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_100, GRAPH_BOTTOM),
-            m_uniqueColors.colorAtRatio(1.0f)));
+            auto const COLOR_TOP{ m_uniqueColors.colorAtRatio(COLOR_TOP_RATIO) };
 
-        lineVerts.push_back(sf::Vertex(
-            sf::Vector2f(GRAPH_LEFT + GRAPH_DISTANCE_TO_100, GRAPH_BOTTOM + PAD),
-            m_uniqueColors.colorAtRatio(1.0f)));
+            auto const COLOR_BOTTOM_RATIO{ 0.0f };
+            auto const COLOR_BOTTOM{ m_uniqueColors.colorAtRatio(COLOR_BOTTOM_RATIO) };
 
-        target.draw(&lineVerts[0], lineVerts.size(), sf::Lines, states);
+            scene.addQuad(
+                sf::Vertex(sf::Vector2f(LEFT, TOP), COLOR_TOP),
+                sf::Vertex(sf::Vector2f(RIGHT, TOP), COLOR_TOP),
+                sf::Vertex(sf::Vector2f(RIGHT, BOTTOM), COLOR_BOTTOM),
+                sf::Vertex(sf::Vector2f(LEFT, BOTTOM), COLOR_BOTTOM));
+        });
 
-        // graph rects
-        std::vector<sf::Vertex> rectVerts;
-        for (auto const & LENGTH_COUNT_PAIR : LINELEN_MAP)
+        // only worth breaking down if there is more than one kind of file, and each kind is
+        // overlaid as a line through the tops its own bars would have, in with the graph lines
+        // so that more kinds draw no slower
+        auto const & EXTENSION_LINE_METRICS{ PARSED_FILE.extensionLineMetrics() };
+
+        if (EXTENSION_LINE_METRICS.size() < 2)
         {
-            auto const LINE_LENGTH_RATIO{ static_cast<float>(LENGTH_COUNT_PAIR.first) /
-                                          static_cast<float>(lineLengthMax) };
+            return;
+        }
 
-            auto const LINE_COUNT_RATIO{ static_cast<float>(LENGTH_COUNT_PAIR.second) /
-                                         static_cast<float>(lineCountMax) };
+        auto const SERIES_COLOR_RATIO_STEP{ 1.0f /
+                                            static_cast<float>(EXTENSION_LINE_METRICS.size() - 1) };
 
-            auto const LEFT{ (GRAPH_LEFT + (GRAPH_WIDTH * LINE_LENGTH_RATIO)) };
+        auto seriesColorRatio{ 0.0f };
+        auto legendTop{ GRAPH_TOP };
 
-            auto const RIGHT{ (LEFT + RECT_WIDTH) };
-            auto const BOTTOM{ GRAPH_BOTTOM - 1.0f };
-            auto const TOP{ (BOTTOM - (GRAPH_HEIGHT * LINE_COUNT_RATIO)) - 1.0f };
+        for (auto const & PAIR : EXTENSION_LINE_METRICS)
+        {
+            auto const SERIES_COLOR{ m_commonColors.colorAtRatio(seriesColorRatio) };
+            seriesColorRatio += SERIES_COLOR_RATIO_STEP;
 
-            auto const COLOR_TOP_RATIO{ LINE_COUNT_RATIO };
-            auto const COLOR_TOP{ m_uniqueColors.colorAtRatio(COLOR_TOP_RATIO) };
+            auto hasPrevPoint{ false };
+            sf::Vector2f prevPoint(0.0f, 0.0f);
 
-            auto const COLOR_BOTTOM_RATIO{ 0.0f };
-            auto const COLOR_BOTTOM{ m_uniqueColors.colorAtRatio(COLOR_BOTTOM_RATIO) };
+            PAIR.second.forEach([&](const std::size_t LENGTH, const std::size_t COUNT) {
+                auto const POINT{ BAR_TOP(LENGTH, COUNT) };
 
-            rectVerts.push_back(sf::Vertex(sf::Vector2f(LEFT, TOP), COLOR_TOP));
-            rectVerts.push_back(sf::Vertex(sf::Vector2f(RIGHT, TOP), COLOR_TOP));
-            rectVerts.push_back(sf::Vertex(sf::Vector2f(RIGHT, BOTTOM), COLOR_BOTTOM));
-            rectVerts.push_back(sf::Vertex(sf::Vector2f(LEFT, BOTTOM), COLOR_BOTTOM));
-        }
+                if (hasPrevPoint)
+                {
+                    scene.addLine(
+                        sf::Vertex(prevPoint, SERIES_COLOR), sf::Vertex(POINT, SERIES_COLOR));
+                }
 
-        target.draw(&rectVerts[0], rectVerts.size(), sf::Quads, states);
+                prevPoint = POINT;
+                hasPrevPoint = true;
+            });
+
+            auto const LEGEND_LABEL{ ((PAIR.first.empty()) ? "(none)" : PAIR.first) };
+
+            scene.addText(
+                LEGEND_LABEL,
+                LABEL_FONT_SIZE,
+                SERIES_COLOR,
+                sf::Vector2f(GRAPH_RIGHT - LABEL_SIZE(LEGEND_LABEL).x, legendTop));
+
+            legendTop += (static_cast<float>(LABEL_FONT_SIZE) + PAD);
+        }
     }
 
 } // namespace word_stacker
@@ -6,12 +6,25 @@
 #include "args-parser.hpp"
 #include "color-range.hpp"
 #include "file-parser.hpp"
+#include "font-face.hpp"
+#include "glyph-metrics-cache.hpp"
+#include "layout-enum.hpp"
+#include "layout-worker.hpp"
+#include "parse-progress.hpp"
 #include "report-maker.hpp"
+#include "scene.hpp"
+#include "spatial-grid.hpp"
+#include "spiral-packer.hpp"
+#include "text-batch.hpp"
+#include "virtual-canvas.hpp"
 #include "word-list.hpp"
 
 #include <SFML/Graphics.hpp>
 
+#include <chrono>
 #include <cstddef> //for std::size_t
+#include <map>
+#include <memory>
 #include <sstream>
 #include <string>
 #include <vector>
@@ -19,9 +32,6 @@
 namespace word_stacker
 {
 
-    using TextVec_t = std::vector<sf::Text>;
-    using RectVec_t = std::vector<sf::FloatRect>;
-
     struct FreqStats;
 
     // Responsible for displaying a parsed file graphically as stacks of words.
@@ -30,12 +40,14 @@ namespace word_stacker
       public:
         explicit ParseDisplayer(const ArgsParser & ARGS);
 
-        void draw(
-            const ArgsParser & ARGS,
-            const FileParser & PARSED_FILE,
-            sf::RenderTarget & target,
-            sf::RenderStates states) const;
+        ParseDisplayer(const ParseDisplayer &) = delete;
+        ParseDisplayer(ParseDisplayer &&) = delete;
+        ParseDisplayer & operator=(const ParseDisplayer &) = delete;
+        ParseDisplayer & operator=(ParseDisplayer &&) = delete;
+
+        void draw(sf::RenderTarget & target, sf::RenderStates states) const;
 
+        // requestSetup() and then waits for that scene and swaps it in
         void setup(
             ReportMaker & reportMaker,
             const ArgsParser & ARGS,
@@ -43,10 +55,122 @@ namespace word_stacker
             const WordList & COMMON_WORDS,
             const WordList & FLAGGED_WORDS,
             const bool WILL_SHOW_COUNTS,
-            const bool WILL_SHOW_COLUMS,
-            const bool WILL_SHOW_LINELEN_GRAPH = false);
+            const Layout::Enum LAYOUT,
+            const bool WILL_SHOW_LINELEN_GRAPH = false,
+            const Vocabulary::Enum VOCABULARY = Vocabulary::Code);
+
+        // starts making the scene on the layout thread and returns, replacing any request not
+        // started yet, and draw() keeps drawing the last scene until updateScene() swaps this
+        // one in.  The other layouts of the same vocabulary, with and without counts, are made
+        // after it and kept, so asking for any of them again needs no layout at all.  The
+        // layout thread keeps using ARGS, PARSED_FILE, COMMON_WORDS and FLAGGED_WORDS, so they
+        // must outlive this ParseDisplayer.
+        void requestSetup(
+            const ArgsParser & ARGS,
+            const FileParser & PARSED_FILE,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            const Layout::Enum LAYOUT,
+            const bool WILL_SHOW_LINELEN_GRAPH = false,
+            const Vocabulary::Enum VOCABULARY = Vocabulary::Code);
+
+        // like requestSetup() but only the one scene, laid out from WORDS instead of a parsed
+        // file, see ParseProgress::snapshot().  It is shown until the next preview replaces it,
+        // and thrown away once a scene from requestSetup() is shown.
+        void requestPreview(
+            const ArgsParser & ARGS,
+            const WordCountVec_t & WORDS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            const Layout::Enum LAYOUT);
+
+        // keeps every scene finished since the last call, and swaps in the one of the latest
+        // request if it is made, returning true if that changed the scene drawn
+        bool updateScene(ReportMaker & reportMaker);
+
+        inline bool isSetupPending() const { return m_layoutWorker.isBusy(); }
+
+        // the canvas layout is bigger than the screen, so it is shown through a view that can
+        // be zoomed and panned, and these return true if the scene drawn needs drawing again
+        bool isShowingCanvas() const;
+
+        // FACTOR below one zooms in, and the canvas under SCREEN_POS stays there
+        bool zoomCanvas(const float FACTOR, const sf::Vector2f & SCREEN_POS);
+
+        bool panCanvas(const sf::Vector2f & SCREEN_OFFSET);
+
+        // a bar along the bottom of the screen, over whatever scene is drawn, with how many
+        // files and bytes are parsed so far
+        void drawParseProgress(
+            sf::RenderTarget & target,
+            sf::RenderStates states,
+            const ParseProgress & PROGRESS) const;
 
       private:
+        // runs on the layout thread, and only uses the members that only it uses
+        std::unique_ptr<Scene> makeScene(
+            const ArgsParser & ARGS,
+            const FileParser & PARSED_FILE,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const SceneKey & KEY);
+
+        // the most frequent of PARSED_WORDS laid out how KEY says, also on the layout thread
+        std::unique_ptr<Scene> makeWordScene(
+            const ArgsParser & ARGS,
+            const WordCountVec_t & PARSED_WORDS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const SceneKey & KEY);
+
+        // returns how many words SETUP(FONT_SIZE_MAX) displayed, after at most two layout
+        // passes, first at the largest font size that FITS(WORD_BOUNDS, FONT_SIZE) predicts
+        // the most frequent WORD will fit at, and if that was wrong then again with the
+        // prediction corrected by how far off it was from the real glyphs at that size
+        template <typename Fits_t, typename Setup_t>
+        std::size_t setupAtLargestFontSize(
+            const ArgsParser & ARGS, const std::string & WORD, Fits_t FITS, Setup_t SETUP);
+
+        // lays out a jumble or spiral with each word whose rank and font size are the same as
+        // in the last layout of KEY where it was before, and searches only for places for the
+        // rest, or returns zero having laid out nothing if there is no last layout, more than
+        // ARGS.layoutChurnMax() percent of its words changed, or the most frequent word no
+        // longer fits
+        std::size_t setupFromLastLayout(
+            const ArgsParser & ARGS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const SceneKey & KEY,
+            WordCountVec_t & wordCounts);
+
+        // PLACE(WORDS_INDEX, POSITION_PTR) puts the words that have a LAST_POSITION_PTRS first,
+        // then the rest in order, and wordCounts is left with only the words that were placed
+        template <typename Place_t>
+        std::size_t placeKeptWordsFirst(
+            const std::vector<const sf::Vector2f *> & LAST_POSITION_PTRS,
+            const bool WILL_STOP_AT_FIRST_MISS,
+            WordCountVec_t & wordCounts,
+            Place_t PLACE);
+
+        // keeps what m_layoutPlacements has for the next layout of KEY
+        void recordPlacements(const SceneKey & KEY, const std::size_t DISPLAYED_COUNT);
+
+        // from zero for the least frequent of WORDS up to one for the most frequent
+        static float frequencyRatio(const WordCountVec_t & WORDS, const std::size_t WORDS_INDEX);
+
+        static unsigned fontSizeAt(
+            const ArgsParser & ARGS, const float FREQ_RATIO, const unsigned FONT_SIZE_MAX);
+
+        // red if flagged, else from the common colors by common order if common, else from the
+        // unique colors by FREQ_RATIO
+        const sf::Color wordColor(
+            const std::string & WORD,
+            const float FREQ_RATIO,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS) const;
+
         std::size_t setupAsColumns(
             const ArgsParser & ARGS,
             const WordList & COMMON_WORDS,
@@ -77,24 +201,75 @@ namespace word_stacker
             const unsigned FONT_SIZE_MAX,
             WordCountVec_t & wordCounts);
 
+        // if POSITION_PTR is not null the word is only tried there, see findNextJumblePosition()
         bool placeNextJumbledWord(
             const ArgsParser & ARGS,
             const WordList & COMMON_WORDS,
             const WordList & FLAGGED_WORDS,
             const bool WILL_SHOW_COUNTS,
-            RectVec_t & rects,
+            SpatialGrid & grid,
             const WordCountVec_t & WORDS,
             const std::size_t WORDS_INDEX,
-            const unsigned FONT_SIZE_MAX);
+            const unsigned FONT_SIZE_MAX,
+            const sf::Vector2f * const POSITION_PTR = nullptr);
+
+        std::size_t setupAsSpiral(
+            const ArgsParser & ARGS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            WordCountVec_t & wordCounts);
+
+        // words that do not fit are skipped instead of ending the layout, and wordCounts is
+        // left with only the words that were placed
+        std::size_t setupAsSpiralAtFontSize(
+            const ArgsParser & ARGS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            const unsigned FONT_SIZE_MAX,
+            WordCountVec_t & wordCounts);
+
+        // if POSITION_PTR is not null the word is only tried there, see SpiralPacker::placeAt()
+        bool placeNextSpiralWord(
+            const ArgsParser & ARGS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            SpiralPacker & packer,
+            const WordCountVec_t & WORDS,
+            const std::size_t WORDS_INDEX,
+            const unsigned FONT_SIZE_MAX,
+            const sf::Vector2f * const POSITION_PTR = nullptr);
+
+        // covers the cells under every glyph of STRING, which fit much tighter than its bounds,
+        // with OFFSET where sf::Text would put the origin of its local bounds
+        void addGlyphsToSprite(
+            const sf::String & STRING,
+            const unsigned FONT_SIZE,
+            const sf::Vector2f & OFFSET,
+            OccupancyBitmap & sprite) const;
 
+        // if POSITION_PTR is not null returns it if it is still valid, and negative if not
         const sf::Vector2f findNextJumblePosition(
             const ArgsParser & ARGS,
             const sf::Vector2f & SIZE,
-            const RectVec_t & INVALID_RECTS) const;
+            const SpatialGrid & GRID,
+            const sf::Vector2f * const POSITION_PTR = nullptr) const;
 
         // returns zero if the given TEST_RECT is already in a valid position
         float findNextLowestValidPosition(
-            const sf::FloatRect & TEST_RECT, const RectVec_t & INVALID_RECTS) const;
+            const sf::FloatRect & TEST_RECT, const SpatialGrid & GRID) const;
+
+        // every word on one canvas several screens wide, see VirtualCanvas
+        std::size_t setupAsCanvas(
+            const ArgsParser & ARGS,
+            const WordList & COMMON_WORDS,
+            const WordList & FLAGGED_WORDS,
+            const bool WILL_SHOW_COUNTS,
+            const WordCountVec_t & WORDS);
+
+        void clampCanvasView();
 
         void loadFont(const ArgsParser & ARGS);
 
@@ -110,19 +285,83 @@ namespace word_stacker
 
         void logStatistics(ReportMaker &, const FreqStats &);
 
-        void drawLineLengthGraph(
-            const ArgsParser & ARGS,
-            const FileParser & PARSED_FILE,
-            sf::RenderTarget & target,
-            sf::RenderStates states) const;
+        // the bars, lines, and labels are all made into the scene, so drawing it is only a
+        // matter of drawing its vertexes and texts
+        void setupLineLengthGraph(const ArgsParser & ARGS, const FileParser & PARSED_FILE);
 
       private:
+        // Responsible for wrapping a finished scene with the vertexes that draw it, which are
+        // only made the first time the scene is shown.
+        struct CachedScene
+        {
+            std::unique_ptr<const Scene> sceneUPtr{};
+            std::unique_ptr<TextBatch> textBatchUPtr{};
+
+            // instead of textBatchUPtr if the scene is bigger than the screen
+            std::unique_ptr<VirtualCanvas> canvasUPtr{};
+
+            // the font rasterizes and uploads each glyph the first time it is asked for, so
+            // this is most of what the first frame of the scene costs
+            std::chrono::steady_clock::duration textBatchDuration{ 0 };
+        };
+
+        // Responsible for wrapping where one word of a jumble or spiral layout was put.
+        struct Placement
+        {
+            std::size_t wordsIndex{ 0 };
+            std::string word{};
+            unsigned fontSize{ 0 };
+
+            // the top-left of the rect or sprite the word was placed by
+            sf::Vector2f position{};
+        };
+
+        // Responsible for wrapping every placement of the last layout of one SceneKey.
+        struct PlacementRecord
+        {
+            unsigned fontSizeMax{ 0 };
+            std::vector<Placement> placements{};
+        };
+
         static const std::size_t M_GRADIENT_DEPTH;
+        static const unsigned M_FONT_SIZES_PER_DOUBLING;
+        static const float M_JUMBLE_GRID_CELL_SIZE;
+        static const float M_SPIRAL_CELL_SIZE;
+        static const std::size_t M_SPIRAL_LEVEL_COUNT;
+        static const std::size_t M_CANVAS_WORD_COUNT_MAX;
+        static const float M_CANVAS_ZOOM_IN_MAX;
         ColorRange m_uniqueColors;
         ColorRange m_commonColors;
         sf::Font m_font;
-        TextVec_t m_texts;
-        bool m_willShowLineLengthGraph;
+        FontFace m_fontFace;
+        GlyphMetricsCache m_glyphMetrics;
+
+        // the parse results and the screen size never change, so nothing here is ever stale
+        // except the previews, which are thrown away once a scene that is not one is shown
+        std::map<SceneKey, CachedScene> m_sceneCache;
+        SceneKey m_sceneKey;
+        const CachedScene * m_shownScenePtr;
+        sf::Vector2f m_screenSize;
+        sf::View m_canvasView;
+
+        // only the layout thread uses these, see FontFace for why it does not rasterize
+        FontFace m_layoutFontFace;
+        GlyphMetricsCache m_layoutGlyphMetrics;
+        std::unique_ptr<Scene> m_layoutSceneUPtr;
+        unsigned m_fontSizeMax;
+        std::size_t m_layoutPassCount;
+        std::vector<Placement> m_layoutPlacements;
+
+        // keyed without isPreview, so a scene reuses the placements of its last preview too
+        std::map<SceneKey, PlacementRecord> m_placementRecords;
+
+        // how many words the last layout had, how many of them changed, and how many were kept
+        std::size_t m_lastPlacementCount;
+        std::size_t m_changedPlacementCount;
+        std::size_t m_keptPlacementCount;
+
+        // the last member, so its thread is stopped before anything it uses is destroyed
+        LayoutWorker m_layoutWorker;
     };
 
 } // namespace word_stacker
@@ -0,0 +1,193 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// parse-progress.cpp
+//
+#include "parse-progress.hpp"
+
+#include "concurrent-count-table.hpp"
+
+#include <algorithm>
+#include <map>
+#include <string>
+
+namespace word_stacker
+{
+
+    // the most words any layout shows but the canvas, so a preview of them is never short
+    const std::size_t ParseProgress::WORD_COUNT_MAX{ 5000 };
+
+    const ParseProgress::Clock_t::duration ParseProgress::M_PUBLISH_INTERVAL_MIN{
+        std::chrono::milliseconds(250)
+    };
+
+    // publishing takes at most one part in this many of the time of the thread doing it
+    const std::size_t ParseProgress::M_PUBLISH_COST_RATIO{ 20 };
+
+    ParseProgress::ParseProgress()
+        : m_mutex()
+        , m_slots()
+        , m_version(0)
+        , m_foundFileCount(0)
+        , m_doneFileCount(0)
+        , m_doneByteCount(0)
+        , m_isDiscoveryFinished(false)
+        , m_isCancelled(false)
+        , m_isFinished(false)
+    {}
+
+    void ParseProgress::setSlotCount(const std::size_t SLOT_COUNT)
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_slots.resize(SLOT_COUNT);
+
+        // the first publish waits one interval, so the first snapshot has enough to show
+        auto const FIRST_PUBLISH_TIME{ Clock_t::now() + M_PUBLISH_INTERVAL_MIN };
+
+        for (auto & slot : m_slots)
+        {
+            slot.nextPublishTime = FIRST_PUBLISH_TIME;
+        }
+    }
+
+    void ParseProgress::addDoneFile(const std::size_t BYTE_COUNT)
+    {
+        ++m_doneFileCount;
+        m_doneByteCount += BYTE_COUNT;
+    }
+
+    bool ParseProgress::isPublishDue(const std::size_t SLOT) const
+    {
+        return ((SLOT < m_slots.size()) && (Clock_t::now() >= m_slots[SLOT].nextPublishTime));
+    }
+
+    void ParseProgress::publish(const std::size_t SLOT, const WordCountMap_t & WORD_COUNT_MAP)
+    {
+        auto const START{ Clock_t::now() };
+
+        WordCountVec_t wordCounts;
+        wordCounts.reserve(WORD_COUNT_MAX);
+
+        for (auto const & PAIR : WORD_COUNT_MAP)
+        {
+            keepIfFrequent(wordCounts, PAIR.first, PAIR.second);
+        }
+
+        store(SLOT, wordCounts, START);
+    }
+
+    void ParseProgress::publish(const std::size_t SLOT, const ConcurrentCountTable & COUNT_TABLE)
+    {
+        auto const START{ Clock_t::now() };
+
+        WordCountVec_t wordCounts;
+        wordCounts.reserve(WORD_COUNT_MAX);
+
+        // other threads are still counting into the table, so only one shard is held at a time
+        COUNT_TABLE.forEachLocked([&](const std::string & WORD, const std::size_t COUNT) {
+            keepIfFrequent(wordCounts, WORD, COUNT);
+        });
+
+        store(SLOT, wordCounts, START);
+    }
+
+    std::size_t ParseProgress::snapshot(WordCountVec_t & wordCounts) const
+    {
+        std::map<std::string, std::size_t> sums;
+        std::size_t version{ 0 };
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            version = m_version;
+
+            for (auto const & SLOT : m_slots)
+            {
+                for (auto const & WORD_COUNT : SLOT.wordCounts)
+                {
+                    sums[WORD_COUNT.word()] += WORD_COUNT.count();
+                }
+            }
+        }
+
+        wordCounts.clear();
+        wordCounts.reserve(sums.size());
+
+        for (auto const & PAIR : sums)
+        {
+            wordCounts.emplace_back(PAIR.first, PAIR.second);
+        }
+
+        std::stable_sort(
+            std::begin(wordCounts),
+            std::end(wordCounts),
+            [](const WordCount & A, const WordCount & B) { return (A.count() > B.count()); });
+
+        return version;
+    }
+
+    float ParseProgress::ratio() const
+    {
+        if (m_isFinished)
+        {
+            return 1.0f;
+        }
+
+        auto const FOUND_COUNT{ m_foundFileCount.load() };
+
+        if (FOUND_COUNT == 0)
+        {
+            return 0.0f;
+        }
+
+        return std::min(
+            1.0f,
+            (static_cast<float>(m_doneFileCount.load()) / static_cast<float>(FOUND_COUNT)));
+    }
+
+    void ParseProgress::keepIfFrequent(
+        WordCountVec_t & wordCounts, const std::string & WORD, const std::size_t COUNT)
+    {
+        // a min heap, so the least frequent kept so far is the one to compare with, and only
+        // words that make the cut are ever copied
+        auto const IS_MORE_FREQUENT{ [](const WordCount & A, const WordCount & B) {
+            return (A.count() > B.count());
+        } };
+
+        if (wordCounts.size() < WORD_COUNT_MAX)
+        {
+            wordCounts.emplace_back(WORD, COUNT);
+            std::push_heap(std::begin(wordCounts), std::end(wordCounts), IS_MORE_FREQUENT);
+        }
+        else if (COUNT > wordCounts.front().count())
+        {
+            std::pop_heap(std::begin(wordCounts), std::end(wordCounts), IS_MORE_FREQUENT);
+            wordCounts.back() = WordCount(WORD, COUNT);
+            std::push_heap(std::begin(wordCounts), std::end(wordCounts), IS_MORE_FREQUENT);
+        }
+    }
+
+    void ParseProgress::store(
+        const std::size_t SLOT, WordCountVec_t & wordCounts, const Clock_t::time_point START)
+    {
+        auto const NOW{ Clock_t::now() };
+
+        auto const PUBLISH_INTERVAL{ std::max(
+            M_PUBLISH_INTERVAL_MIN,
+            ((NOW - START) * static_cast<Clock_t::rep>(M_PUBLISH_COST_RATIO))) };
+
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+
+            if (SLOT >= m_slots.size())
+            {
+                return;
+            }
+
+            m_slots[SLOT].wordCounts.swap(wordCounts);
+            m_slots[SLOT].nextPublishTime = (NOW + PUBLISH_INTERVAL);
+        }
+
+        ++m_version;
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,113 @@
+#ifndef WORDSTACKER_PARSEPROGRESS_HPP_INCLUDED
+#define WORDSTACKER_PARSEPROGRESS_HPP_INCLUDED
+//
+// parse-progress.hpp
+//
+#include "parse-counts.hpp"
+#include "word-count.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef> //for std::size_t
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace word_stacker
+{
+
+    class ConcurrentCountTable;
+
+    // Responsible for showing other threads how far a FileParser has gotten while it runs, and
+    // a rough snapshot of the most frequent words so far.  Each tokenizer thread publishes the
+    // top of its own counts now and then, and a snapshot sums what they published, so a word
+    // near the top of only some threads is undercounted until the parse is finished.  Anything
+    // here may be called from any thread, except that each slot is only published to by one.
+    class ParseProgress
+    {
+        using Clock_t = std::chrono::steady_clock;
+
+      public:
+        // how many of the most frequent words of each slot are published
+        static const std::size_t WORD_COUNT_MAX;
+
+        ParseProgress();
+
+        ParseProgress(const ParseProgress &) = delete;
+        ParseProgress(ParseProgress &&) = delete;
+        ParseProgress & operator=(const ParseProgress &) = delete;
+        ParseProgress & operator=(ParseProgress &&) = delete;
+
+        // must be called before any thread publishes
+        void setSlotCount(const std::size_t SLOT_COUNT);
+
+        inline void addFoundFile() { ++m_foundFileCount; }
+        inline void finishDiscovery() { m_isDiscoveryFinished = true; }
+
+        // files skipped as binary or duplicate are done too, so the ratio still reaches one
+        void addDoneFile(const std::size_t BYTE_COUNT);
+
+        // publishing sorts the whole count map, so it is paced to cost a small fraction of the
+        // time of the thread that does it, and this is false until that slot's turn comes again
+        bool isPublishDue(const std::size_t SLOT) const;
+
+        // replaces what SLOT published last with the most frequent words counted so far
+        void publish(const std::size_t SLOT, const WordCountMap_t & WORD_COUNT_MAP);
+        void publish(const std::size_t SLOT, const ConcurrentCountTable & COUNT_TABLE);
+
+        // sorted most frequent first, like FileParser::words(), and returns version()
+        std::size_t snapshot(WordCountVec_t & wordCounts) const;
+
+        // counts up on every publish, so zero means there is nothing to snapshot yet
+        inline std::size_t version() const { return m_version; }
+
+        // the parse checks this between files and stops early, leaving its results incomplete
+        inline void cancel() { m_isCancelled = true; }
+        inline bool isCancelled() const { return m_isCancelled; }
+
+        inline void finish() { m_isFinished = true; }
+        inline bool isFinished() const { return m_isFinished; }
+
+        inline std::size_t foundFileCount() const { return m_foundFileCount; }
+        inline bool isDiscoveryFinished() const { return m_isDiscoveryFinished; }
+        inline std::size_t doneFileCount() const { return m_doneFileCount; }
+        inline std::size_t doneByteCount() const { return m_doneByteCount; }
+
+        // of the files found so far, so it can go backward while more are still being found
+        float ratio() const;
+
+      private:
+        // keeps the WORD_COUNT_MAX most frequent words offered in wordCounts, as a heap
+        static void keepIfFrequent(
+            WordCountVec_t & wordCounts, const std::string & WORD, const std::size_t COUNT);
+
+        void store(
+            const std::size_t SLOT, WordCountVec_t & wordCounts, const Clock_t::time_point START);
+
+      private:
+        static const Clock_t::duration M_PUBLISH_INTERVAL_MIN;
+        static const std::size_t M_PUBLISH_COST_RATIO;
+
+        // Responsible for wrapping what one thread published last.
+        struct Slot
+        {
+            WordCountVec_t wordCounts{};
+
+            // only the thread that publishes to this slot uses it
+            Clock_t::time_point nextPublishTime{};
+        };
+
+        mutable std::mutex m_mutex;
+        std::vector<Slot> m_slots;
+        std::atomic<std::size_t> m_version;
+        std::atomic<std::size_t> m_foundFileCount;
+        std::atomic<std::size_t> m_doneFileCount;
+        std::atomic<std::size_t> m_doneByteCount;
+        std::atomic<bool> m_isDiscoveryFinished;
+        std::atomic<bool> m_isCancelled;
+        std::atomic<bool> m_isFinished;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_PARSEPROGRESS_HPP_INCLUDED
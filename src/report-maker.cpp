@@ -21,6 +21,7 @@ namespace word_stacker
         , m_miscSS()
         , m_fileStatsSS()
         , m_displayStatsSS()
+        , m_windowStatsSS()
     {}
 
     void ReportMaker::make() const
@@ -52,7 +53,8 @@ namespace word_stacker
                  << m_errorsSS.str() << '\n'
                  << m_miscSS.str() << '\n'
                  << m_fileStatsSS.str() << '\n'
-                 << m_displayStatsSS.str() << std::endl;
+                 << m_displayStatsSS.str() << '\n'
+                 << m_windowStatsSS.str() << std::endl;
         }
         catch (...)
         {
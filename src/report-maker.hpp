@@ -33,6 +33,22 @@ namespace word_stacker
 
         inline void displayStatsStreamClear() { m_displayStatsSS.str(""); }
 
+        inline const std::string displayStats() const { return m_displayStatsSS.str(); }
+
+        inline void displayStatsReplace(const std::string & STATS)
+        {
+            displayStatsStreamClear();
+            m_displayStatsSS << STATS;
+        }
+
+        // only known once the window has been open a while, so only make() writes these
+        inline std::stringstream & windowStatsStream()
+        {
+            return prepareStreamForAppend(m_windowStatsSS);
+        }
+
+        inline void windowStatsStreamClear() { m_windowStatsSS.str(""); }
+
         inline std::size_t frequencyListLength() { return 10; }
 
       private:
@@ -45,6 +61,7 @@ namespace word_stacker
         std::stringstream m_miscSS;
         std::stringstream m_fileStatsSS;
         std::stringstream m_displayStatsSS;
+        std::stringstream m_windowStatsSS;
     };
 } // namespace word_stacker
 
@@ -0,0 +1,58 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// scene.cpp
+//
+#include "scene.hpp"
+
+namespace word_stacker
+{
+
+    Scene::Scene(const SceneKey & KEY)
+        : m_key(KEY)
+        , m_texts()
+        , m_chars()
+        , m_fontSizes()
+        , m_lineVerts()
+        , m_quadVerts()
+        , m_canvasSize(0.0f, 0.0f)
+        , m_displayStats()
+    {}
+
+    void Scene::addText(
+        const std::string & STRING,
+        const unsigned FONT_SIZE,
+        const sf::Color & COLOR,
+        const sf::Vector2f & POSITION)
+    {
+        PlacedText text;
+        text.position = POSITION;
+        text.color = COLOR;
+        text.fontSize = FONT_SIZE;
+        text.charIndex = m_chars.size();
+        text.charCount = STRING.size();
+        m_texts.push_back(text);
+
+        m_chars += STRING;
+        m_fontSizes.insert(FONT_SIZE);
+    }
+
+    void Scene::addLine(const sf::Vertex & FROM, const sf::Vertex & TO)
+    {
+        m_lineVerts.push_back(FROM);
+        m_lineVerts.push_back(TO);
+    }
+
+    void Scene::addQuad(
+        const sf::Vertex & TOP_LEFT,
+        const sf::Vertex & TOP_RIGHT,
+        const sf::Vertex & BOTTOM_RIGHT,
+        const sf::Vertex & BOTTOM_LEFT)
+    {
+        m_quadVerts.push_back(TOP_LEFT);
+        m_quadVerts.push_back(TOP_RIGHT);
+        m_quadVerts.push_back(BOTTOM_RIGHT);
+        m_quadVerts.push_back(BOTTOM_LEFT);
+    }
+
+} // namespace word_stacker
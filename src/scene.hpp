@@ -0,0 +1,128 @@
+#ifndef WORDSTACKER_SCENE_HPP_INCLUDED
+#define WORDSTACKER_SCENE_HPP_INCLUDED
+//
+// scene.hpp
+//
+#include "layout-enum.hpp"
+#include "vocabulary-enum.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <set>
+#include <string>
+#include <tuple>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for wrapping the display options that decide what one scene shows.
+    struct SceneKey
+    {
+        bool willShowCounts = false;
+        Layout::Enum layout = Layout::Columns;
+        Vocabulary::Enum vocabulary = Vocabulary::Code;
+        bool willShowLineLengthGraph = false;
+
+        // made from a snapshot of a parse still running, so never kept once the parse is done
+        bool isPreview = false;
+    };
+
+    inline bool operator<(const SceneKey & LEFT, const SceneKey & RIGHT)
+    {
+        return (
+            std::tie(
+                LEFT.willShowCounts,
+                LEFT.layout,
+                LEFT.vocabulary,
+                LEFT.willShowLineLengthGraph,
+                LEFT.isPreview) <
+            std::tie(
+                RIGHT.willShowCounts,
+                RIGHT.layout,
+                RIGHT.vocabulary,
+                RIGHT.willShowLineLengthGraph,
+                RIGHT.isPreview));
+    }
+
+    inline bool operator==(const SceneKey & LEFT, const SceneKey & RIGHT)
+    {
+        return !((LEFT < RIGHT) || (RIGHT < LEFT));
+    }
+
+    // Responsible for wrapping where one placed string goes and how it looks.  The characters
+    // are kept by the Scene, all in one buffer.
+    struct PlacedText
+    {
+        sf::Vector2f position{ 0.0f, 0.0f };
+        sf::Color color{ sf::Color::White };
+        unsigned fontSize = 0;
+        std::size_t charIndex = 0;
+        std::size_t charCount = 0;
+    };
+
+    // Responsible for holding everything one layout decided, without any of the font textures
+    // or vertexes needed to draw it, so it can be made on one thread and shown on another.  Once
+    // made it is never changed, so showing it again is only a matter of swapping it back in.
+    // Shapes that need no font, like the bars of the line length graph, are kept as the
+    // vertexes to draw since those are plain data too.
+    class Scene
+    {
+      public:
+        explicit Scene(const SceneKey & KEY = SceneKey());
+
+        // POSITION is where the local origin of sf::Text would be, see TextBatch::add()
+        void addText(
+            const std::string & STRING,
+            const unsigned FONT_SIZE,
+            const sf::Color & COLOR,
+            const sf::Vector2f & POSITION);
+
+        void addLine(const sf::Vertex & FROM, const sf::Vertex & TO);
+
+        // in the same order sf::Quads would want them
+        void addQuad(
+            const sf::Vertex & TOP_LEFT,
+            const sf::Vertex & TOP_RIGHT,
+            const sf::Vertex & BOTTOM_RIGHT,
+            const sf::Vertex & BOTTOM_LEFT);
+
+        inline const std::vector<PlacedText> & texts() const { return m_texts; }
+        inline const std::vector<sf::Vertex> & lineVerts() const { return m_lineVerts; }
+        inline const std::vector<sf::Vertex> & quadVerts() const { return m_quadVerts; }
+
+        inline const std::string string(const PlacedText & TEXT) const
+        {
+            return m_chars.substr(TEXT.charIndex, TEXT.charCount);
+        }
+
+        // TextBatch needs one draw call for the texture page of each of these
+        inline const std::set<unsigned> & fontSizes() const { return m_fontSizes; }
+
+        inline const SceneKey & key() const { return m_key; }
+
+        // zero unless the layout is bigger than the screen, see VirtualCanvas
+        inline const sf::Vector2f & canvasSize() const { return m_canvasSize; }
+        inline void setCanvasSize(const sf::Vector2f & SIZE) { m_canvasSize = SIZE; }
+
+        inline bool willShowLineLengthGraph() const { return m_key.willShowLineLengthGraph; }
+
+        // what ReportMaker::displayStatsStream() would hold after this layout
+        inline const std::string & displayStats() const { return m_displayStats; }
+        inline void setDisplayStats(const std::string & STATS) { m_displayStats = STATS; }
+
+      private:
+        SceneKey m_key;
+        std::vector<PlacedText> m_texts;
+        std::string m_chars;
+        std::set<unsigned> m_fontSizes;
+        std::vector<sf::Vertex> m_lineVerts;
+        std::vector<sf::Vertex> m_quadVerts;
+        sf::Vector2f m_canvasSize;
+        std::string m_displayStats;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_SCENE_HPP_INCLUDED
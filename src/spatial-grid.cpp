@@ -0,0 +1,98 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// spatial-grid.cpp
+//
+#include "spatial-grid.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace word_stacker
+{
+
+    SpatialGrid::SpatialGrid(const float WIDTH, const float HEIGHT, const float CELL_SIZE)
+        : M_CELL_SIZE(CELL_SIZE)
+        , M_COLUMN_COUNT(static_cast<std::size_t>(std::max(1.0f, std::ceil(WIDTH / CELL_SIZE))))
+        , M_ROW_COUNT(static_cast<std::size_t>(std::max(1.0f, std::ceil(HEIGHT / CELL_SIZE))))
+        , m_rects()
+        , m_cells(M_COLUMN_COUNT * M_ROW_COUNT)
+        , m_testCount(0)
+    {}
+
+    void SpatialGrid::insert(const sf::FloatRect & RECT)
+    {
+        auto const INDEX{ m_rects.size() };
+        m_rects.push_back(RECT);
+
+        auto const COLUMN_LAST{ columnAt(RECT.left + RECT.width) };
+        auto const ROW_LAST{ rowAt(RECT.top + RECT.height) };
+
+        for (auto row{ rowAt(RECT.top) }; row <= ROW_LAST; ++row)
+        {
+            for (auto column{ columnAt(RECT.left) }; column <= COLUMN_LAST; ++column)
+            {
+                m_cells[(row * M_COLUMN_COUNT) + column].push_back(INDEX);
+            }
+        }
+    }
+
+    float SpatialGrid::overlappingBottom(const sf::FloatRect & RECT) const
+    {
+        auto const RECT_RIGHT{ RECT.left + RECT.width };
+        auto const RECT_BOTTOM{ RECT.top + RECT.height };
+
+        auto const COLUMN_LAST{ columnAt(RECT_RIGHT) };
+        auto const ROW_LAST{ rowAt(RECT_BOTTOM) };
+
+        auto bottom{ 0.0f };
+
+        for (auto row{ rowAt(RECT.top) }; row <= ROW_LAST; ++row)
+        {
+            for (auto column{ columnAt(RECT.left) }; column <= COLUMN_LAST; ++column)
+            {
+                // a rect in more than one of these cells is tested more than once, which is
+                // cheaper than keeping track of which were already tested
+                for (auto const INDEX : m_cells[(row * M_COLUMN_COUNT) + column])
+                {
+                    ++m_testCount;
+
+                    auto const & PLACED_RECT{ m_rects[INDEX] };
+                    auto const PLACED_RECT_RIGHT{ PLACED_RECT.left + PLACED_RECT.width };
+                    auto const PLACED_RECT_BOTTOM{ PLACED_RECT.top + PLACED_RECT.height };
+
+                    if ((std::max(RECT.left, PLACED_RECT.left) <
+                         std::min(RECT_RIGHT, PLACED_RECT_RIGHT)) &&
+                        (std::max(RECT.top, PLACED_RECT.top) <
+                         std::min(RECT_BOTTOM, PLACED_RECT_BOTTOM)))
+                    {
+                        bottom = std::max(bottom, PLACED_RECT_BOTTOM);
+                    }
+                }
+            }
+        }
+
+        return bottom;
+    }
+
+    std::size_t SpatialGrid::columnAt(const float X) const
+    {
+        if (X <= 0.0f)
+        {
+            return 0;
+        }
+
+        return std::min((M_COLUMN_COUNT - 1), static_cast<std::size_t>(X / M_CELL_SIZE));
+    }
+
+    std::size_t SpatialGrid::rowAt(const float Y) const
+    {
+        if (Y <= 0.0f)
+        {
+            return 0;
+        }
+
+        return std::min((M_ROW_COUNT - 1), static_cast<std::size_t>(Y / M_CELL_SIZE));
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,48 @@
+#ifndef WORDSTACKER_SPATIALGRID_HPP_INCLUDED
+#define WORDSTACKER_SPATIALGRID_HPP_INCLUDED
+//
+// spatial-grid.hpp
+//
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for finding which of many placed rects overlap a test rect without looking at
+    // all of them.  The area is cut into square cells and each rect is listed in every cell it
+    // touches, so a query only looks at the rects listed in the few cells under the test rect.
+    // Rects outside the area are clamped into the cells along its edges, so nothing is missed.
+    class SpatialGrid
+    {
+      public:
+        SpatialGrid(const float WIDTH, const float HEIGHT, const float CELL_SIZE);
+
+        void insert(const sf::FloatRect & RECT);
+
+        // returns the lowest bottom of all the rects that overlap RECT, or zero if none do
+        float overlappingBottom(const sf::FloatRect & RECT) const;
+
+        inline std::size_t size() const { return m_rects.size(); }
+
+        // how many rects all queries so far had to test, to tell how well the cells are working
+        inline std::size_t testCount() const { return m_testCount; }
+
+      private:
+        std::size_t columnAt(const float X) const;
+        std::size_t rowAt(const float Y) const;
+
+      private:
+        const float M_CELL_SIZE;
+        const std::size_t M_COLUMN_COUNT;
+        const std::size_t M_ROW_COUNT;
+        std::vector<sf::FloatRect> m_rects;
+        std::vector<std::vector<std::size_t>> m_cells;
+        mutable std::size_t m_testCount;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_SPATIALGRID_HPP_INCLUDED
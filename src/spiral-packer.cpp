@@ -0,0 +1,232 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// spiral-packer.cpp
+//
+#include "spiral-packer.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace word_stacker
+{
+
+    SpiralPacker::SpiralPacker(
+        const std::size_t WIDTH, const std::size_t HEIGHT, const std::size_t LEVEL_COUNT)
+        : m_occupancy(WIDTH, HEIGHT, LEVEL_COUNT)
+        , m_points()
+        , m_firstUncoveredIndex(0)
+        , m_failedSizes()
+    {
+        // all in cells, with the spiral stretched sideways to fill the area evenly
+        auto const WIDTH_F{ static_cast<float>(m_occupancy.width()) };
+        auto const HEIGHT_F{ static_cast<float>(m_occupancy.height()) };
+        auto const CENTER_LEFT{ WIDTH_F * 0.5f };
+        auto const CENTER_TOP{ HEIGHT_F * 0.5f };
+        auto const ASPECT{ WIDTH_F / HEIGHT_F };
+        auto const RADIUS_MAX{ std::hypot((CENTER_LEFT / ASPECT), CENTER_TOP) };
+        auto const TURN_SPACING{ 2.0f };
+        auto const STEP{ 1.0f };
+        auto const TWO_PI{ 6.2831853f };
+
+        m_points.reserve(static_cast<std::size_t>((WIDTH_F * HEIGHT_F) / (TURN_SPACING * STEP)));
+
+        // outside the area, so it is never inside a sprite put there
+        const sf::Vector2u NEVER_BLOCKED_CELL{ static_cast<unsigned>(m_occupancy.width() + 1),
+                                               static_cast<unsigned>(m_occupancy.height() + 1) };
+
+        sf::Vector2u prevCell{ NEVER_BLOCKED_CELL };
+        auto angle{ 0.0f };
+        auto radius{ 0.0f };
+
+        while (radius <= RADIUS_MAX)
+        {
+            auto const LEFT{ std::floor(CENTER_LEFT + (radius * ASPECT * std::cos(angle))) };
+            auto const TOP{ std::floor(CENTER_TOP + (radius * std::sin(angle))) };
+
+            // take steps of about STEP cells along the wide side of the spiral
+            angle += (STEP / std::max((radius * ASPECT), STEP));
+            radius = ((TURN_SPACING * angle) / TWO_PI);
+
+            if ((LEFT < 0.0f) || (LEFT >= WIDTH_F) || (TOP < 0.0f) || (TOP >= HEIGHT_F))
+            {
+                continue;
+            }
+
+            const sf::Vector2u CELL{ static_cast<unsigned>(LEFT), static_cast<unsigned>(TOP) };
+
+            // near the center many steps land on the same cell
+            if (CELL != prevCell)
+            {
+                m_points.push_back({ CELL, NEVER_BLOCKED_CELL });
+                prevCell = CELL;
+            }
+        }
+    }
+
+    const sf::Vector2i SpiralPacker::place(const OccupancyBitmap & SPRITE)
+    {
+        const sf::Vector2u SIZE{ static_cast<unsigned>(SPRITE.width()),
+                                 static_cast<unsigned>(SPRITE.height()) };
+
+        // a heuristic, since sprites are shaped like their glyphs and anchored differently, see
+        // m_failedSizes
+        auto const IS_TOO_BIG{ std::any_of(
+            std::begin(m_failedSizes), std::end(m_failedSizes), [&](const sf::Vector2u & FAILED) {
+                return ((SIZE.x >= FAILED.x) && (SIZE.y >= FAILED.y));
+            }) };
+
+        if (IS_TOO_BIG || (SIZE.x > m_occupancy.width()) || (SIZE.y > m_occupancy.height()))
+        {
+            return sf::Vector2i(-1, -1);
+        }
+
+        while ((m_firstUncoveredIndex < m_points.size()) &&
+               m_occupancy.isCovered(
+                   m_points[m_firstUncoveredIndex].cell.x, m_points[m_firstUncoveredIndex].cell.y))
+        {
+            ++m_firstUncoveredIndex;
+        }
+
+        auto const ANCHOR{ findAnchor(SPRITE) };
+        auto const LEFT_MAX{ static_cast<unsigned>(m_occupancy.width()) - SIZE.x };
+        auto const TOP_MAX{ static_cast<unsigned>(m_occupancy.height()) - SIZE.y };
+
+        std::size_t coveredCount{ 0 };
+        sf::Vector2i position{ -1, -1 };
+
+        for (auto index{ m_firstUncoveredIndex }; index < m_points.size(); ++index)
+        {
+            auto & point{ m_points[index] };
+            auto const & CELL{ point.cell };
+
+            if (m_occupancy.isCovered(CELL.x, CELL.y))
+            {
+                ++coveredCount;
+                continue;
+            }
+
+            if ((CELL.x < ANCHOR.x) || (CELL.y < ANCHOR.y))
+            {
+                continue;
+            }
+
+            auto const LEFT{ CELL.x - ANCHOR.x };
+            auto const TOP{ CELL.y - ANCHOR.y };
+
+            if ((LEFT > LEFT_MAX) || (TOP > TOP_MAX))
+            {
+                continue;
+            }
+
+            // the blocked cell is still covered, so if SPRITE would cover it too it cannot fit
+            auto const & BLOCKED{ point.blockedCell };
+
+            auto const IS_BLOCKED{ (
+                (BLOCKED.x >= LEFT) && (BLOCKED.y >= TOP) && ((BLOCKED.x - LEFT) < SIZE.x) &&
+                ((BLOCKED.y - TOP) < SIZE.y) &&
+                SPRITE.isCovered((BLOCKED.x - LEFT), (BLOCKED.y - TOP))) };
+
+            if (IS_BLOCKED)
+            {
+                continue;
+            }
+
+            std::size_t overlapLeft{ 0 };
+            std::size_t overlapTop{ 0 };
+
+            if (m_occupancy.overlaps(SPRITE, LEFT, TOP, overlapLeft, overlapTop))
+            {
+                point.blockedCell = sf::Vector2u(
+                    static_cast<unsigned>(overlapLeft), static_cast<unsigned>(overlapTop));
+            }
+            else
+            {
+                m_occupancy.add(SPRITE, LEFT, TOP);
+                position = sf::Vector2i(static_cast<int>(LEFT), static_cast<int>(TOP));
+                break;
+            }
+        }
+
+        if (position.x < 0)
+        {
+            m_failedSizes.push_back(SIZE);
+        }
+
+        // covered points are never uncovered, so once stepping over them is a good part of
+        // the work they are dropped, keeping the order of those left
+        if (coveredCount > (m_points.size() / 8))
+        {
+            m_points.erase(
+                std::remove_if(
+                    (std::begin(m_points) + static_cast<long>(m_firstUncoveredIndex)),
+                    std::end(m_points),
+                    [&](const Point & POINT) {
+                        return m_occupancy.isCovered(POINT.cell.x, POINT.cell.y);
+                    }),
+                std::end(m_points));
+        }
+
+        return position;
+    }
+
+    const sf::Vector2i
+        SpiralPacker::placeAt(const OccupancyBitmap & SPRITE, const sf::Vector2i & CELL)
+    {
+        const sf::Vector2i NOT_PLACED{ -1, -1 };
+
+        if ((CELL.x < 0) || (CELL.y < 0))
+        {
+            return NOT_PLACED;
+        }
+
+        auto const LEFT{ static_cast<std::size_t>(CELL.x) };
+        auto const TOP{ static_cast<std::size_t>(CELL.y) };
+
+        if (((LEFT + SPRITE.width()) > m_occupancy.width()) ||
+            ((TOP + SPRITE.height()) > m_occupancy.height()) ||
+            m_occupancy.overlaps(SPRITE, LEFT, TOP))
+        {
+            return NOT_PLACED;
+        }
+
+        m_occupancy.add(SPRITE, LEFT, TOP);
+        return CELL;
+    }
+
+    const sf::Vector2u SpiralPacker::findAnchor(const OccupancyBitmap & SPRITE)
+    {
+        auto const WIDTH{ static_cast<unsigned>(SPRITE.width()) };
+        auto const HEIGHT{ static_cast<unsigned>(SPRITE.height()) };
+        const sf::Vector2u CENTER{ (WIDTH / 2), (HEIGHT / 2) };
+
+        // look along the middle row first, out from the center both ways
+        for (unsigned offset(0); offset <= CENTER.x; ++offset)
+        {
+            if (SPRITE.isCovered((CENTER.x - offset), CENTER.y))
+            {
+                return sf::Vector2u((CENTER.x - offset), CENTER.y);
+            }
+
+            if (((CENTER.x + offset) < WIDTH) && SPRITE.isCovered((CENTER.x + offset), CENTER.y))
+            {
+                return sf::Vector2u((CENTER.x + offset), CENTER.y);
+            }
+        }
+
+        for (unsigned top(0); top < HEIGHT; ++top)
+        {
+            for (unsigned left(0); left < WIDTH; ++left)
+            {
+                if (SPRITE.isCovered(left, top))
+                {
+                    return sf::Vector2u(left, top);
+                }
+            }
+        }
+
+        // an empty sprite overlaps nothing, so any point works as well as any other
+        return CENTER;
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,65 @@
+#ifndef WORDSTACKER_SPIRALPACKER_HPP_INCLUDED
+#define WORDSTACKER_SPIRALPACKER_HPP_INCLUDED
+//
+// spiral-packer.hpp
+//
+#include "occupancy-bitmap.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for packing sprites as close to the center of an OccupancyBitmap as they fit,
+    // by trying the points of an Archimedean spiral out from the center in order.  Each sprite
+    // is anchored on one of its own covered cells, so a point that is already covered can never
+    // work and costs only one bit test, and since cells never uncover, every sprite starts
+    // from the first point that was still uncovered instead of from the center.  For the same
+    // reason a cell that blocked one sprite at a point blocks any sprite that would cover it
+    // there too, so each point keeps the last cell that blocked it and skips those sprites.
+    class SpiralPacker
+    {
+      public:
+        SpiralPacker(
+            const std::size_t WIDTH, const std::size_t HEIGHT, const std::size_t LEVEL_COUNT);
+
+        // returns the cell the top-left of SPRITE was put at, or negative if it will not fit
+        const sf::Vector2i place(const OccupancyBitmap & SPRITE);
+
+        // like place() but only tries the top-left of SPRITE at CELL, where it was put before
+        const sf::Vector2i placeAt(const OccupancyBitmap & SPRITE, const sf::Vector2i & CELL);
+
+        inline std::size_t pointCount() const { return m_points.size(); }
+        inline std::size_t fineTestCount() const { return m_occupancy.fineTestCount(); }
+
+      private:
+        // returns the covered cell nearest the middle of SPRITE
+        static const sf::Vector2u findAnchor(const OccupancyBitmap & SPRITE);
+
+      private:
+        // Responsible for wrapping one point of the spiral with the covered cell that last kept
+        // a sprite from fitting there, or one outside the area if none has yet.
+        struct Point
+        {
+            sf::Vector2u cell{};
+            sf::Vector2u blockedCell{};
+        };
+
+      private:
+        OccupancyBitmap m_occupancy;
+        std::vector<Point> m_points;
+        std::size_t m_firstUncoveredIndex;
+
+        // the sizes of sprites that did not fit anywhere, and any sprite at least as big in
+        // both directions is not tried at all.  Unlike Point::blockedCell this can turn away a
+        // sprite that would have fit, about one in a few hundred, but trying every point for
+        // each of the thousands of words that no longer fit makes the layout 15-25x slower.
+        std::vector<sf::Vector2u> m_failedSizes;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_SPIRALPACKER_HPP_INCLUDED
@@ -0,0 +1,518 @@
+#ifndef WORDSTACKER_STREAMINGTOKENIZER_HPP_INCLUDED
+#define WORDSTACKER_STREAMINGTOKENIZER_HPP_INCLUDED
+//
+// streaming-tokenizer.hpp
+//
+#include "parse-counts.hpp"
+#include "parse-type-enum.hpp"
+#include "strings.hpp"
+#include "tokenize-policy.hpp"
+#include "vocabulary-enum.hpp"
+
+#include <cstddef> //for std::size_t
+#include <string>
+
+namespace word_stacker
+{
+
+    // longer words are counted as overlong and then dropped instead of being kept
+    constexpr std::size_t TOKENIZER_WORD_LENGTH_MAX{ 1024 };
+
+    // Responsible for splitting text or code into words one chunk at a time, without ever holding
+    // a whole line.  Chunks can end anywhere, even in the middle of a word, so the only memory
+    // used is for the word being built, no matter how long the lines are.  The words found and
+    // the line counts/lengths recorded are exactly what splitting whole lines would give.
+    // Both the TokenizePolicy and what is done with each word are template parameters so that the
+    // per character loop is compiled separately for each, with nothing decided at runtime.
+    // Code identifiers can also be split into their parts, see splitWord(), and the words in
+    // comments and strings can be kept instead of skipped.  Those are tokenized like Text and
+    // sent with their Vocabulary, so one pass over the code fills all three vocabularies.
+    template <typename Policy_t, typename WordSink_t>
+    class StreamingTokenizer
+    {
+        static constexpr ParseType::Enum M_PARSE_TYPE{ Policy_t::M_PARSE_TYPE };
+
+      public:
+        StreamingTokenizer(ParseCounts & counts, WordSink_t & wordSink)
+            : m_counts(counts)
+            , m_wordSink(wordSink)
+            , m_word()
+            , m_part()
+            , m_isWordOverlong(false)
+            , m_isLineStarted(false)
+            , m_lineLength(0)
+            , m_hyphenRunLength(0)
+            , m_hasNonWhitespace(false)
+            , m_isCommentLine(false)
+            , m_isInComment(false)
+            , m_isInBlockComment(false)
+            , m_isStarPending(false)
+            , m_isSlashPending(false)
+            , m_isBackslashPending(false)
+            , m_isInString(false)
+            , m_vocabulary(Vocabulary::Code)
+        {
+            static_assert(
+                ((M_PARSE_TYPE == ParseType::Text) || (M_PARSE_TYPE == ParseType::Code)),
+                "StreamingTokenizer only supports ParseType::Text and ParseType::Code.");
+
+            m_word.reserve(TOKENIZER_WORD_LENGTH_MAX);
+
+            if constexpr (Policy_t::M_WILL_SPLIT_IDENTIFIERS)
+            {
+                m_part.reserve(TOKENIZER_WORD_LENGTH_MAX);
+            }
+        }
+
+        void feed(const char * const BEGIN, const std::size_t SIZE)
+        {
+            for (const char * iter(BEGIN); iter != (BEGIN + SIZE); ++iter)
+            {
+                auto const CH{ *iter };
+
+                // carriage returns are dropped as if they were never there
+                if ('\r' == CH)
+                {
+                    m_isLineStarted = true;
+                    continue;
+                }
+
+                if ('\n' == CH)
+                {
+                    endLine();
+                    continue;
+                }
+
+                m_isLineStarted = true;
+                ++m_lineLength;
+
+                if constexpr (M_PARSE_TYPE == ParseType::Text)
+                {
+                    feedText(CH);
+                }
+                else
+                {
+                    feedCode(CH);
+                }
+            }
+        }
+
+        // ends the last line even if there was no newline at the end
+        void finish()
+        {
+            if (m_isLineStarted)
+            {
+                endLine();
+            }
+        }
+
+      private:
+        void feedText(const char CH)
+        {
+            // "--" appears in lots of poems, so every second hyphen in a row is skipped
+            if ('-' == CH)
+            {
+                if ((++m_hyphenRunLength % 2) == 1)
+                {
+                    appendToWord(CH);
+                }
+
+                return;
+            }
+
+            m_hyphenRunLength = 0;
+
+            auto const CH_LOWER{ ((CH >= 'A') && (CH <= 'Z')) ? static_cast<char>(CH + 32) : CH };
+
+            if (((CH_LOWER >= 'a') && (CH_LOWER <= 'z')) || ('\'' == CH_LOWER))
+            {
+                appendToWord(CH_LOWER);
+            }
+            else
+            {
+                endWord();
+            }
+        }
+
+        // code is handled in three steps, each may hold one char until it sees the next:
+        // cutting off // and /* */ comments, then removing escaped quotes, then blanking out
+        // strings
+        void feedCode(const char CH)
+        {
+            if (m_isInComment)
+            {
+                if constexpr (Policy_t::M_WILL_SPLIT_VOCABULARIES)
+                {
+                    feedText(CH);
+                }
+
+                return;
+            }
+
+            // a block comment can span lines and chunks, so only the */ ends it
+            if (m_isInBlockComment)
+            {
+                m_isCommentLine = true;
+
+                if (m_isStarPending && ('/' == CH))
+                {
+                    m_isStarPending = false;
+                    m_isInBlockComment = false;
+                    endWord();
+                    m_vocabulary = Vocabulary::Code;
+                    return;
+                }
+
+                m_isStarPending = ('*' == CH);
+
+                if constexpr (Policy_t::M_WILL_SPLIT_VOCABULARIES)
+                {
+                    feedText(CH);
+                }
+
+                return;
+            }
+
+            if (m_isSlashPending)
+            {
+                m_isSlashPending = false;
+
+                if (('/' == CH) || ('*' == CH))
+                {
+                    m_isInComment = ('/' == CH);
+                    m_isInBlockComment = ('*' == CH);
+                    m_isCommentLine = true;
+
+                    if (m_isBackslashPending)
+                    {
+                        m_isBackslashPending = false;
+                        feedCodeUnquoted('\\');
+                    }
+
+                    endWord();
+                    m_vocabulary = Vocabulary::Comments;
+                    return;
+                }
+
+                m_hasNonWhitespace = true;
+                feedCodeUnescaped('/');
+            }
+
+            // a // or /* in a string, like in a url or a glob, does not start a comment
+            if (('/' == CH) && !m_isInString)
+            {
+                m_isSlashPending = true;
+                return;
+            }
+
+            if (!utilz::isWhitespace(CH))
+            {
+                m_hasNonWhitespace = true;
+            }
+
+            feedCodeUnescaped(CH);
+        }
+
+        void feedCodeUnescaped(const char CH)
+        {
+            // escaped quotes are removed entirely, even the backslash
+            if (m_isBackslashPending)
+            {
+                m_isBackslashPending = false;
+
+                if ('\"' == CH)
+                {
+                    return;
+                }
+
+                feedCodeUnquoted('\\');
+
+                // the rest of an escape like \n is not part of a word in a string
+                if constexpr (Policy_t::M_WILL_SPLIT_VOCABULARIES)
+                {
+                    if (m_isInString)
+                    {
+                        return;
+                    }
+                }
+
+                // nor does it start another escape, so the quote ending "\\" is not escaped
+                feedCodeUnquoted(CH);
+                return;
+            }
+
+            if ('\\' == CH)
+            {
+                m_isBackslashPending = true;
+                return;
+            }
+
+            feedCodeUnquoted(CH);
+        }
+
+        void feedCodeUnquoted(const char CH)
+        {
+            // text in double quotes is skipped, unless it is kept as a vocabulary of its own
+            if ('\"' == CH)
+            {
+                endWord();
+                m_isInString = !m_isInString;
+                m_vocabulary = ((m_isInString) ? Vocabulary::Strings : Vocabulary::Code);
+                return;
+            }
+
+            if (m_isInString)
+            {
+                if constexpr (Policy_t::M_WILL_SPLIT_VOCABULARIES)
+                {
+                    feedText(CH);
+                }
+
+                return;
+            }
+
+            auto const IS_WORD_CHAR{ (
+                ((CH >= 'a') && (CH <= 'z')) || ((CH >= 'A') && (CH <= 'Z')) ||
+                ((CH >= '0') && (CH <= '9')) || ('_' == CH)) };
+
+            if (IS_WORD_CHAR)
+            {
+                appendToWord(CH);
+            }
+            else
+            {
+                endWord();
+            }
+        }
+
+        void appendToWord(const char CH)
+        {
+            if (m_word.size() < TOKENIZER_WORD_LENGTH_MAX)
+            {
+                m_word.push_back(CH);
+            }
+            else
+            {
+                m_isWordOverlong = true;
+            }
+        }
+
+        void endWord()
+        {
+            if (m_word.empty())
+            {
+                return;
+            }
+
+            if (m_isWordOverlong)
+            {
+                ++m_counts.overlongCount;
+                m_isWordOverlong = false;
+                m_word.clear();
+                return;
+            }
+
+            if ((M_PARSE_TYPE == ParseType::Text) || (m_vocabulary != Vocabulary::Code))
+            {
+                utilz::trimIfNot(
+                    m_word, [](const char CH) { return !((CH == '\'') || (CH == '-')); });
+
+                // remove trailing 's
+                if (m_word.size() >= 4)
+                {
+                    if ((m_word[m_word.size() - 2] == '\'') && (m_word[m_word.size() - 1] == 's'))
+                    {
+                        m_word.resize(m_word.size() - 2);
+                    }
+                }
+            }
+
+            if constexpr (Policy_t::M_WILL_SPLIT_IDENTIFIERS)
+            {
+                if (m_vocabulary == Vocabulary::Code)
+                {
+                    splitWord();
+                    m_word.clear();
+                    return;
+                }
+            }
+
+            m_wordSink(m_word, m_vocabulary);
+            m_word.clear();
+        }
+
+        // sends the lowercase parts of m_word one at a time, split on underscores, on lower to
+        // upper case, on the last of a run of capitals before lower case, and on letters to
+        // digits, so parseHTTPFile2 is parse, http, file, and 2.  The parts are built in m_part,
+        // which has the same capacity as m_word, so nothing is allocated.  An identifier with
+        // only one part is sent unchanged, just as if identifiers were not split, and one with
+        // more parts is only sent whole as well when identifiers are kept.
+        void splitWord()
+        {
+            auto const SIZE{ m_word.size() };
+            std::size_t partCount{ 0 };
+
+            for (std::size_t i(0); i < SIZE; ++i)
+            {
+                if (isPartStart(i))
+                {
+                    ++partCount;
+                }
+            }
+
+            if (partCount < 2)
+            {
+                m_wordSink(m_word, Vocabulary::Code);
+                return;
+            }
+
+            ++m_counts.splitIdentifierCount;
+
+            for (std::size_t i(0); i < SIZE; ++i)
+            {
+                auto const CH{ m_word[i] };
+
+                if ('_' == CH)
+                {
+                    continue;
+                }
+
+                if (isPartStart(i))
+                {
+                    endPart();
+                }
+
+                m_part.push_back((isUpper(CH)) ? static_cast<char>(CH + 32) : CH);
+            }
+
+            endPart();
+
+            if constexpr (Policy_t::M_WILL_KEEP_IDENTIFIERS)
+            {
+                m_wordSink(m_word, Vocabulary::Code);
+            }
+        }
+
+        // true if the char at INDEX in m_word is the first of a part, underscores never are
+        bool isPartStart(const std::size_t INDEX) const
+        {
+            auto const CH{ m_word[INDEX] };
+
+            if ('_' == CH)
+            {
+                return false;
+            }
+
+            if ((0 == INDEX) || ('_' == m_word[INDEX - 1]))
+            {
+                return true;
+            }
+
+            auto const PREV{ m_word[INDEX - 1] };
+            auto const NEXT{ ((INDEX + 1) < m_word.size()) ? m_word[INDEX + 1] : '\0' };
+
+            return (
+                (isLower(PREV) && isUpper(CH)) ||
+                (isUpper(PREV) && isUpper(CH) && isLower(NEXT)) ||
+                (isDigit(PREV) != isDigit(CH)));
+        }
+
+        void endPart()
+        {
+            if (m_part.empty())
+            {
+                return;
+            }
+
+            m_wordSink(m_part, Vocabulary::Code);
+            m_part.clear();
+        }
+
+        static bool isLower(const char CH) { return ((CH >= 'a') && (CH <= 'z')); }
+        static bool isUpper(const char CH) { return ((CH >= 'A') && (CH <= 'Z')); }
+        static bool isDigit(const char CH) { return ((CH >= '0') && (CH <= '9')); }
+
+        void endLine()
+        {
+            if constexpr (M_PARSE_TYPE == ParseType::Code)
+            {
+                if (m_isSlashPending)
+                {
+                    m_isSlashPending = false;
+                    m_hasNonWhitespace = true;
+                    feedCodeUnescaped('/');
+                }
+
+                if (m_isBackslashPending)
+                {
+                    m_isBackslashPending = false;
+                    feedCodeUnquoted('\\');
+                }
+            }
+
+            endWord();
+
+            ++m_counts.lineCount;
+            ++m_counts.unCLineCount;
+
+            if constexpr (M_PARSE_TYPE == ParseType::Text)
+            {
+                m_counts.fileLineMetrics.add(m_lineLength);
+            }
+            else
+            {
+                // a line is a comment line if it has a comment and no code before or after it
+                if (m_isCommentLine && !m_hasNonWhitespace)
+                {
+                    --m_counts.unCLineCount;
+                }
+                else if (m_hasNonWhitespace)
+                {
+                    // blank lines and comment lines are not counted in the line lengths of code
+                    m_counts.fileLineMetrics.add(m_lineLength);
+                }
+            }
+
+            m_isLineStarted = false;
+            m_lineLength = 0;
+            m_hyphenRunLength = 0;
+            m_hasNonWhitespace = false;
+            m_isInComment = false;
+            m_isStarPending = false;
+            m_isInString = false;
+
+            // the lines inside a block comment, even blank ones, are comment lines
+            m_isCommentLine = m_isInBlockComment;
+            m_vocabulary = ((m_isInBlockComment) ? Vocabulary::Comments : Vocabulary::Code);
+        }
+
+      private:
+        ParseCounts & m_counts;
+        WordSink_t & m_wordSink;
+        std::string m_word;
+
+        // code only, the part of m_word being built when identifiers are split
+        std::string m_part;
+
+        bool m_isWordOverlong;
+        bool m_isLineStarted;
+        std::size_t m_lineLength;
+
+        // text, and the comments and strings of code
+        std::size_t m_hyphenRunLength;
+
+        // code only
+        bool m_hasNonWhitespace;
+        bool m_isCommentLine;
+        bool m_isInComment;
+        bool m_isInBlockComment;
+        bool m_isStarPending;
+        bool m_isSlashPending;
+        bool m_isBackslashPending;
+        bool m_isInString;
+        Vocabulary::Enum m_vocabulary;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_STREAMINGTOKENIZER_HPP_INCLUDED
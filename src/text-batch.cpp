@@ -0,0 +1,121 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// text-batch.cpp
+//
+#include "text-batch.hpp"
+
+namespace word_stacker
+{
+
+    TextBatch::TextBatch(const sf::Font & FONT, const GlyphMetricsCache & GLYPH_METRICS)
+        : m_font(FONT)
+        , m_glyphMetrics(GLYPH_METRICS)
+        , m_pages()
+    {}
+
+    void TextBatch::add(
+        const std::string & STRING,
+        const unsigned FONT_SIZE,
+        const sf::Color & COLOR,
+        const sf::Vector2f & POSITION)
+    {
+        // the glyphs are already scaled from their page, see GlyphMetricsCache::pageSize()
+        auto const PAGE_SIZE{ m_glyphMetrics.pageSize(FONT_SIZE) };
+        auto const SCALE{ static_cast<float>(FONT_SIZE) / static_cast<float>(PAGE_SIZE) };
+
+        auto & vertexArray{ m_pages[PAGE_SIZE] };
+        vertexArray.setPrimitiveType(sf::Triangles);
+
+        // see sf::Text::ensureGeometryUpdate(), which starts the first baseline one character
+        // size down, and words and counts never have line breaks so those are spaces here too
+        const sf::String SF_STRING(STRING);
+        auto horizPos{ 0.0f };
+        auto const VERT_POS{ static_cast<float>(FONT_SIZE) };
+        sf::Uint32 prevChar{ 0 };
+
+        for (std::size_t i(0); i < SF_STRING.getSize(); ++i)
+        {
+            auto const CHAR{ SF_STRING[i] };
+            horizPos += m_glyphMetrics.kerning(prevChar, CHAR, FONT_SIZE);
+            prevChar = CHAR;
+
+            if ((CHAR == ' ') || (CHAR == '\t') || (CHAR == '\n'))
+            {
+                horizPos += (m_glyphMetrics.glyph(' ', FONT_SIZE).advance *
+                             ((CHAR == '\t') ? 4.0f : 1.0f));
+
+                continue;
+            }
+
+            auto const & GLYPH{ m_glyphMetrics.glyph(CHAR, FONT_SIZE) };
+
+            appendGlyphQuad(
+                vertexArray, (POSITION + sf::Vector2f(horizPos, VERT_POS)), COLOR, GLYPH, SCALE);
+
+            horizPos += GLYPH.advance;
+        }
+    }
+
+    void TextBatch::add(const Scene & SCENE)
+    {
+        for (auto const & TEXT : SCENE.texts())
+        {
+            add(SCENE.string(TEXT), TEXT.fontSize, TEXT.color, TEXT.position);
+        }
+    }
+
+    void TextBatch::clear() { m_pages.clear(); }
+
+    void TextBatch::draw(sf::RenderTarget & target, sf::RenderStates states) const
+    {
+        drawPages(target, states, 0);
+    }
+
+    void TextBatch::drawPages(
+        sf::RenderTarget & target, sf::RenderStates states, const unsigned PAGE_SIZE_MIN) const
+    {
+        // the font adds glyphs to a page as they are first asked for, so only ask for the
+        // texture now that all the glyphs drawn with it are in it
+        for (auto iter(m_pages.lower_bound(PAGE_SIZE_MIN)); iter != std::end(m_pages); ++iter)
+        {
+            states.texture = &m_font.getTexture(iter->first);
+            target.draw(iter->second, states);
+        }
+    }
+
+    void TextBatch::appendGlyphQuad(
+        sf::VertexArray & vertexArray,
+        const sf::Vector2f & POSITION,
+        const sf::Color & COLOR,
+        const sf::Glyph & GLYPH,
+        const float SCALE)
+    {
+        // sfml pads each glyph by a pixel of its page so smoothing does not cut off the edges,
+        // and that pixel is scaled along with the glyph as the transform of sf::Text would
+        auto const PADDING{ 1.0f * SCALE };
+        auto const TEXTURE_PADDING{ 1.0f };
+
+        auto const LEFT{ POSITION.x + GLYPH.bounds.left - PADDING };
+        auto const TOP{ POSITION.y + GLYPH.bounds.top - PADDING };
+        auto const RIGHT{ POSITION.x + GLYPH.bounds.left + GLYPH.bounds.width + PADDING };
+        auto const BOTTOM{ POSITION.y + GLYPH.bounds.top + GLYPH.bounds.height + PADDING };
+
+        auto const U1{ static_cast<float>(GLYPH.textureRect.left) - TEXTURE_PADDING };
+        auto const V1{ static_cast<float>(GLYPH.textureRect.top) - TEXTURE_PADDING };
+
+        auto const U2{ static_cast<float>(GLYPH.textureRect.left + GLYPH.textureRect.width) +
+                       TEXTURE_PADDING };
+
+        auto const V2{ static_cast<float>(GLYPH.textureRect.top + GLYPH.textureRect.height) +
+                       TEXTURE_PADDING };
+
+        vertexArray.append(sf::Vertex(sf::Vector2f(LEFT, TOP), COLOR, sf::Vector2f(U1, V1)));
+        vertexArray.append(sf::Vertex(sf::Vector2f(RIGHT, TOP), COLOR, sf::Vector2f(U2, V1)));
+        vertexArray.append(sf::Vertex(sf::Vector2f(LEFT, BOTTOM), COLOR, sf::Vector2f(U1, V2)));
+        vertexArray.append(sf::Vertex(sf::Vector2f(LEFT, BOTTOM), COLOR, sf::Vector2f(U1, V2)));
+        vertexArray.append(sf::Vertex(sf::Vector2f(RIGHT, TOP), COLOR, sf::Vector2f(U2, V1)));
+        vertexArray.append(sf::Vertex(sf::Vector2f(RIGHT, BOTTOM), COLOR, sf::Vector2f(U2, V2)));
+    }
+
+} // namespace word_stacker
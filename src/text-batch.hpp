@@ -0,0 +1,73 @@
+#ifndef WORDSTACKER_TEXTBATCH_HPP_INCLUDED
+#define WORDSTACKER_TEXTBATCH_HPP_INCLUDED
+//
+// text-batch.hpp
+//
+#include "glyph-metrics-cache.hpp"
+#include "scene.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <map>
+#include <string>
+
+namespace word_stacker
+{
+
+    // Responsible for drawing many single line strings of one font with one draw call for each
+    // texture page, instead of one for each string.  The font keeps a separate texture page for
+    // each character size, so the glyph quads of every string are written into the vertex array
+    // of the page its glyphs come from, exactly as sf::Text would write them.  When that page is
+    // a larger size, see GlyphMetricsCache::pageSize(), the quads are scaled down as they are
+    // written, since one transform for each string would take one draw call for each.  Only the
+    // vertexes are kept, the strings themselves are kept by the Scene they came from.
+    class TextBatch : public sf::Drawable
+    {
+      public:
+        TextBatch(const sf::Font & FONT, const GlyphMetricsCache & GLYPH_METRICS);
+
+        TextBatch(const TextBatch &) = delete;
+        TextBatch(TextBatch &&) = delete;
+        TextBatch & operator=(const TextBatch &) = delete;
+        TextBatch & operator=(TextBatch &&) = delete;
+
+        // POSITION is where the local origin of sf::Text would be, so the same as an sf::Text
+        // with the same position and origin would be drawn at getPosition() - getOrigin()
+        void add(
+            const std::string & STRING,
+            const unsigned FONT_SIZE,
+            const sf::Color & COLOR,
+            const sf::Vector2f & POSITION);
+
+        // adds every text in SCENE
+        void add(const Scene & SCENE);
+
+        void clear();
+
+        void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+        // draws only the texture pages of PAGE_SIZE_MIN and larger
+        void drawPages(
+            sf::RenderTarget & target,
+            sf::RenderStates states,
+            const unsigned PAGE_SIZE_MIN) const;
+
+      private:
+        // see the addGlyphQuad() function in sfml's Text.cpp
+        static void appendGlyphQuad(
+            sf::VertexArray & vertexArray,
+            const sf::Vector2f & POSITION,
+            const sf::Color & COLOR,
+            const sf::Glyph & GLYPH,
+            const float SCALE);
+
+      private:
+        const sf::Font & m_font;
+        const GlyphMetricsCache & m_glyphMetrics;
+        std::map<unsigned, sf::VertexArray> m_pages;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_TEXTBATCH_HPP_INCLUDED
@@ -0,0 +1,64 @@
+#ifndef WORDSTACKER_TOKENIZEPOLICY_HPP_INCLUDED
+#define WORDSTACKER_TOKENIZEPOLICY_HPP_INCLUDED
+//
+// tokenize-policy.hpp
+//
+#include "parse-type-enum.hpp"
+
+#include <string>
+
+namespace word_stacker
+{
+
+    // Responsible for fixing at compile time every choice that changes how each word is handled.
+    // FileParser instantiates its tokenizing kernel once per combination and picks one of them
+    // once per run, so a feature that is turned off costs no branches in the inner loops.
+    // The flags after IS_SHARED_COUNT only mean something for Code, so Text leaves them false.
+    template <
+        ParseType::Enum PARSE_TYPE,
+        bool WILL_SKIP_COMMON,
+        bool HAS_IGNORED,
+        bool HAS_FLAGGED,
+        bool IS_SHARED_COUNT,
+        bool WILL_SPLIT_IDENTIFIERS = false,
+        bool WILL_KEEP_IDENTIFIERS = false,
+        bool WILL_SPLIT_VOCABULARIES = false>
+    struct TokenizePolicy
+    {
+        static constexpr ParseType::Enum M_PARSE_TYPE{ PARSE_TYPE };
+        static constexpr bool M_WILL_SKIP_COMMON{ WILL_SKIP_COMMON };
+        static constexpr bool M_HAS_IGNORED{ HAS_IGNORED };
+        static constexpr bool M_HAS_FLAGGED{ HAS_FLAGGED };
+        static constexpr bool M_IS_SHARED_COUNT{ IS_SHARED_COUNT };
+
+        static constexpr bool M_WILL_SPLIT_IDENTIFIERS{ (
+            (PARSE_TYPE == ParseType::Code) && WILL_SPLIT_IDENTIFIERS) };
+
+        static constexpr bool M_WILL_KEEP_IDENTIFIERS{ (
+            M_WILL_SPLIT_IDENTIFIERS && WILL_KEEP_IDENTIFIERS) };
+
+        static constexpr bool M_WILL_SPLIT_VOCABULARIES{ (
+            (PARSE_TYPE == ParseType::Code) && WILL_SPLIT_VOCABULARIES) };
+
+        static const std::string name()
+        {
+            std::string str{ ParseType::toString(PARSE_TYPE) };
+            str += ((WILL_SKIP_COMMON) ? " +common" : " -common");
+            str += ((HAS_IGNORED) ? " +ignored" : " -ignored");
+            str += ((HAS_FLAGGED) ? " +flagged" : " -flagged");
+            str += ((IS_SHARED_COUNT) ? " +shared" : " -shared");
+
+            if (PARSE_TYPE == ParseType::Code)
+            {
+                str += ((M_WILL_SPLIT_IDENTIFIERS) ? " +split" : " -split");
+                str += ((M_WILL_KEEP_IDENTIFIERS) ? " +keep" : " -keep");
+                str += ((M_WILL_SPLIT_VOCABULARIES) ? " +vocabularies" : " -vocabularies");
+            }
+
+            return str;
+        }
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_TOKENIZEPOLICY_HPP_INCLUDED
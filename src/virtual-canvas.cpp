@@ -0,0 +1,217 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// virtual-canvas.cpp
+//
+#include "virtual-canvas.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace word_stacker
+{
+
+    const std::size_t VirtualCanvas::M_TILES_ACROSS_MAX{ 16 };
+    const float VirtualCanvas::M_TILE_SIZE_MIN{ 512.0f };
+    const float VirtualCanvas::M_TEXT_PIXEL_SIZE_MIN{ 6.0f };
+    const float VirtualCanvas::M_BAR_PIXEL_SIZE_MIN{ 1.0f };
+
+    VirtualCanvas::VirtualCanvas(
+        const sf::Font & FONT, const GlyphMetricsCache & GLYPH_METRICS, const Scene & SCENE)
+        : m_size(SCENE.canvasSize())
+        , m_tileSize(std::max(
+              M_TILE_SIZE_MIN,
+              (std::max(m_size.x, m_size.y) / static_cast<float>(M_TILES_ACROSS_MAX))))
+        , m_columnCount(static_cast<std::size_t>(std::ceil(m_size.x / m_tileSize)) + 1)
+        , m_rowCount(static_cast<std::size_t>(std::ceil(m_size.y / m_tileSize)) + 1)
+        , m_overflowColumnCount(0)
+        , m_overflowRowCount(0)
+        , m_tiles(m_columnCount * m_rowCount)
+    {
+        for (auto & tile : m_tiles)
+        {
+            tile.textBatchUPtr = std::make_unique<TextBatch>(FONT, GLYPH_METRICS);
+        }
+
+        // the bars are only sorted once every word is in its tile, so collect them first
+        std::vector<std::vector<std::size_t>> tileTextIndexes(m_tiles.size());
+        std::vector<sf::FloatRect> textBounds;
+        textBounds.reserve(SCENE.texts().size());
+
+        for (std::size_t i(0); i < SCENE.texts().size(); ++i)
+        {
+            auto const & TEXT{ SCENE.texts()[i] };
+            auto const STRING{ SCENE.string(TEXT) };
+
+            auto bounds{ GLYPH_METRICS.bounds(STRING, TEXT.fontSize) };
+            bounds.left += TEXT.position.x;
+            bounds.top += TEXT.position.y;
+            textBounds.push_back(bounds);
+
+            auto const COLUMN{ columnAt(bounds.left) };
+            auto const ROW{ rowAt(bounds.top) };
+
+            m_overflowColumnCount =
+                std::max(m_overflowColumnCount, (columnAt(bounds.left + bounds.width) - COLUMN));
+
+            m_overflowRowCount =
+                std::max(m_overflowRowCount, (rowAt(bounds.top + bounds.height) - ROW));
+
+            auto const TILE_INDEX{ (ROW * m_columnCount) + COLUMN };
+            auto & tile{ m_tiles[TILE_INDEX] };
+
+            if (tileTextIndexes[TILE_INDEX].empty())
+            {
+                tile.bounds = bounds;
+            }
+            else
+            {
+                auto const RIGHT{ std::max(
+                    (tile.bounds.left + tile.bounds.width), (bounds.left + bounds.width)) };
+
+                auto const BOTTOM{ std::max(
+                    (tile.bounds.top + tile.bounds.height), (bounds.top + bounds.height)) };
+
+                tile.bounds.left = std::min(tile.bounds.left, bounds.left);
+                tile.bounds.top = std::min(tile.bounds.top, bounds.top);
+                tile.bounds.width = (RIGHT - tile.bounds.left);
+                tile.bounds.height = (BOTTOM - tile.bounds.top);
+            }
+
+            tile.textBatchUPtr->add(STRING, TEXT.fontSize, TEXT.color, TEXT.position);
+            tileTextIndexes[TILE_INDEX].push_back(i);
+        }
+
+        for (std::size_t t(0); t < m_tiles.size(); ++t)
+        {
+            auto & tile{ m_tiles[t] };
+            auto & textIndexes{ tileTextIndexes[t] };
+
+            std::stable_sort(
+                std::begin(textIndexes),
+                std::end(textIndexes),
+                [&](const std::size_t LEFT, const std::size_t RIGHT) {
+                    return (SCENE.texts()[LEFT].fontSize < SCENE.texts()[RIGHT].fontSize);
+                });
+
+            tile.barVerts.reserve(textIndexes.size() * 4);
+            tile.barPageSizes.reserve(textIndexes.size());
+
+            for (auto const TEXT_INDEX : textIndexes)
+            {
+                auto const & TEXT{ SCENE.texts()[TEXT_INDEX] };
+                auto const & BOUNDS{ textBounds[TEXT_INDEX] };
+
+                // half as tall as the word and centered on it, so rows of bars read as rows
+                auto const LEFT{ BOUNDS.left };
+                auto const RIGHT{ BOUNDS.left + BOUNDS.width };
+                auto const TOP{ BOUNDS.top + (BOUNDS.height * 0.25f) };
+                auto const BOTTOM{ BOUNDS.top + (BOUNDS.height * 0.75f) };
+
+                tile.barVerts.push_back(sf::Vertex(sf::Vector2f(LEFT, TOP), TEXT.color));
+                tile.barVerts.push_back(sf::Vertex(sf::Vector2f(RIGHT, TOP), TEXT.color));
+                tile.barVerts.push_back(sf::Vertex(sf::Vector2f(RIGHT, BOTTOM), TEXT.color));
+                tile.barVerts.push_back(sf::Vertex(sf::Vector2f(LEFT, BOTTOM), TEXT.color));
+
+                tile.barPageSizes.push_back(GLYPH_METRICS.pageSize(TEXT.fontSize));
+            }
+        }
+    }
+
+    void VirtualCanvas::draw(sf::RenderTarget & target, sf::RenderStates states) const
+    {
+        auto const & VIEW{ target.getView() };
+
+        const sf::FloatRect VIEW_RECT(
+            (VIEW.getCenter() - (VIEW.getSize() * 0.5f)), VIEW.getSize());
+
+        if ((VIEW_RECT.width <= 0.0f) || (VIEW_RECT.height <= 0.0f))
+        {
+            return;
+        }
+
+        // how many pixels of the target one unit of the canvas is drawn with
+        auto const SCALE{ static_cast<float>(target.getSize().y) / VIEW_RECT.height };
+
+        // pages smaller than this on screen are drawn as bars, and smaller than that not at all
+        auto const TEXT_PAGE_SIZE_MIN{ static_cast<unsigned>(
+            std::ceil(M_TEXT_PIXEL_SIZE_MIN / SCALE)) };
+
+        auto const BAR_PAGE_SIZE_MIN{ static_cast<unsigned>(
+            std::ceil(M_BAR_PIXEL_SIZE_MIN / SCALE)) };
+
+        // words reach past their own tile, so start that many tiles before the view
+        auto const COLUMN_BEGIN{ columnAt(VIEW_RECT.left) -
+                                 std::min(columnAt(VIEW_RECT.left), m_overflowColumnCount) };
+
+        auto const ROW_BEGIN{ rowAt(VIEW_RECT.top) -
+                              std::min(rowAt(VIEW_RECT.top), m_overflowRowCount) };
+
+        auto const COLUMN_END{ columnAt(VIEW_RECT.left + VIEW_RECT.width) + 1 };
+        auto const ROW_END{ rowAt(VIEW_RECT.top + VIEW_RECT.height) + 1 };
+
+        for (std::size_t row(ROW_BEGIN); row < ROW_END; ++row)
+        {
+            for (std::size_t column(COLUMN_BEGIN); column < COLUMN_END; ++column)
+            {
+                auto const & TILE{ m_tiles[(row * m_columnCount) + column] };
+
+                if (TILE.barPageSizes.empty() || (TILE.bounds.intersects(VIEW_RECT) == false))
+                {
+                    continue;
+                }
+
+                // sorted by page size, so the bars to draw are the run between the two sizes
+                auto const BARS_BEGIN{ static_cast<std::size_t>(
+                    std::lower_bound(
+                        std::begin(TILE.barPageSizes),
+                        std::end(TILE.barPageSizes),
+                        BAR_PAGE_SIZE_MIN) -
+                    std::begin(TILE.barPageSizes)) };
+
+                auto const BARS_END{ static_cast<std::size_t>(
+                    std::lower_bound(
+                        std::begin(TILE.barPageSizes),
+                        std::end(TILE.barPageSizes),
+                        TEXT_PAGE_SIZE_MIN) -
+                    std::begin(TILE.barPageSizes)) };
+
+                if (BARS_END > BARS_BEGIN)
+                {
+                    target.draw(
+                        &TILE.barVerts[BARS_BEGIN * 4],
+                        ((BARS_END - BARS_BEGIN) * 4),
+                        sf::Quads,
+                        states);
+                }
+
+                TILE.textBatchUPtr->drawPages(target, states, TEXT_PAGE_SIZE_MIN);
+            }
+        }
+    }
+
+    std::size_t VirtualCanvas::columnAt(const float X) const
+    {
+        auto const COLUMN{ std::floor(X / m_tileSize) };
+
+        if (COLUMN <= 0.0f)
+        {
+            return 0;
+        }
+
+        return std::min((m_columnCount - 1), static_cast<std::size_t>(COLUMN));
+    }
+
+    std::size_t VirtualCanvas::rowAt(const float Y) const
+    {
+        auto const ROW{ std::floor(Y / m_tileSize) };
+
+        if (ROW <= 0.0f)
+        {
+            return 0;
+        }
+
+        return std::min((m_rowCount - 1), static_cast<std::size_t>(ROW));
+    }
+
+} // namespace word_stacker
@@ -0,0 +1,82 @@
+#ifndef WORDSTACKER_VIRTUALCANVAS_HPP_INCLUDED
+#define WORDSTACKER_VIRTUALCANVAS_HPP_INCLUDED
+//
+// virtual-canvas.hpp
+//
+#include "glyph-metrics-cache.hpp"
+#include "scene.hpp"
+#include "text-batch.hpp"
+
+#include <SFML/Graphics.hpp>
+
+#include <cstddef> //for std::size_t
+#include <memory>
+#include <vector>
+
+namespace word_stacker
+{
+
+    // Responsible for drawing a scene far bigger than the screen through the view of whatever
+    // it is drawn to, at a cost that depends on the view instead of how many words there are.
+    // The canvas is cut into square tiles, each with its own TextBatch, and only the tiles under
+    // the view are drawn.  The tiles are the spatial index, so finding them is only a matter of
+    // dividing the view rect by the tile size.  Words too small on screen to read are drawn as
+    // bars of their color, and words too small to see are not drawn at all.  There are never
+    // more than M_TILES_ACROSS_MAX tiles across, so zoomed all the way out the draw calls are
+    // still bounded, and the bars are sorted by size so each tile draws its bars in one call.
+    class VirtualCanvas : public sf::Drawable
+    {
+      public:
+        VirtualCanvas(
+            const sf::Font & FONT, const GlyphMetricsCache & GLYPH_METRICS, const Scene & SCENE);
+
+        VirtualCanvas(const VirtualCanvas &) = delete;
+        VirtualCanvas(VirtualCanvas &&) = delete;
+        VirtualCanvas & operator=(const VirtualCanvas &) = delete;
+        VirtualCanvas & operator=(VirtualCanvas &&) = delete;
+
+        inline const sf::Vector2f & size() const { return m_size; }
+        inline std::size_t columnCount() const { return m_columnCount; }
+        inline std::size_t rowCount() const { return m_rowCount; }
+        inline float tileSize() const { return m_tileSize; }
+
+        void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+
+      private:
+        // Responsible for wrapping the words whose bounds start in one tile.
+        struct Tile
+        {
+            // of all the words in the tile, which can reach into the tiles right and below
+            sf::FloatRect bounds{};
+
+            std::unique_ptr<TextBatch> textBatchUPtr{};
+
+            // four for each word, sorted by the texture page the word would be drawn from
+            std::vector<sf::Vertex> barVerts{};
+            std::vector<unsigned> barPageSizes{};
+        };
+
+        std::size_t columnAt(const float X) const;
+        std::size_t rowAt(const float Y) const;
+
+      private:
+        static const std::size_t M_TILES_ACROSS_MAX;
+        static const float M_TILE_SIZE_MIN;
+        static const float M_TEXT_PIXEL_SIZE_MIN;
+        static const float M_BAR_PIXEL_SIZE_MIN;
+
+        sf::Vector2f m_size;
+        float m_tileSize;
+        std::size_t m_columnCount;
+        std::size_t m_rowCount;
+
+        // how many tiles past its own the words of any tile reach
+        std::size_t m_overflowColumnCount;
+        std::size_t m_overflowRowCount;
+
+        std::vector<Tile> m_tiles;
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_VIRTUALCANVAS_HPP_INCLUDED
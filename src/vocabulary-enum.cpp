@@ -0,0 +1,39 @@
+// This is an open source non-commercial project. Dear PVS-Studio, please check it.
+// PVS-Studio Static Code Analyzer for C, C++ and C#: http://www.viva64.com
+//
+// vocabulary-enum.cpp
+//
+#include "vocabulary-enum.hpp"
+
+#include <sstream>
+
+namespace word_stacker
+{
+
+    const std::string Vocabulary::toString(const Vocabulary::Enum E)
+    {
+        switch (E)
+        {
+            case Code:
+            {
+                return "Code";
+            }
+            case Comments:
+            {
+                return "Comments";
+            }
+            case Strings:
+            {
+                return "Strings";
+            }
+            case Count:
+            default:
+            {
+                std::ostringstream ss;
+                ss << "(invalid Vocabulary::Enum=" << E << ")";
+                return ss.str();
+            }
+        }
+    }
+
+} // namespace word_stacker
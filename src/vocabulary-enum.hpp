@@ -0,0 +1,27 @@
+#ifndef WORDSTACKER_VOCABULARYENUM_HPP_INCLUDED
+#define WORDSTACKER_VOCABULARYENUM_HPP_INCLUDED
+//
+// vocabulary-enum.hpp
+//
+#include <string>
+
+namespace word_stacker
+{
+
+    // which part of the code a word was found in, Text is always Code
+    struct Vocabulary
+    {
+        enum Enum
+        {
+            Code = 0,
+            Comments,
+            Strings,
+            Count
+        };
+
+        static const std::string toString(const Enum);
+    };
+
+} // namespace word_stacker
+
+#endif // WORDSTACKER_VOCABULARYENUM_HPP_INCLUDED